@@ -37,6 +37,7 @@
 #include "UIGrid.h"
 #include "Scale.h"
 #include "ModulationChain.h"
+#include "RealtimePool.h"
 
 class Arpeggiator : public NoteEffectBase, public IDrawableModule, public ITimeListener, public IButtonListener, public IDropdownListener, public IIntSliderListener, public IFloatSliderListener, public IScaleListener
 {
@@ -109,7 +110,7 @@ private:
       int voiceIdx;
       ModulationParameters modulation;
    };
-   std::vector<ArpNote> mChord;
+   std::vector<ArpNote, RealtimeAllocator<ArpNote>> mChord;
 
    float mWidth;
    float mHeight;
@@ -34,8 +34,9 @@ BandVocoder::BandVocoder()
    mCarrierInputBuffer = new float[GetBuffer()->BufferSize()];
    Clear(mCarrierInputBuffer, GetBuffer()->BufferSize());
 
-   mWorkBuffer = new float[GetBuffer()->BufferSize()];
-   Clear(mWorkBuffer, GetBuffer()->BufferSize());
+   static_assert(VOCODER_MAX_BANDS <= BiquadFilterBank::kMaxFilters, "filter bank is too small for the band count");
+   mBandBuffer = new float[GetBuffer()->BufferSize() * VOCODER_MAX_BANDS];
+   Clear(mBandBuffer, GetBuffer()->BufferSize() * VOCODER_MAX_BANDS);
 
    mOutBuffer = new float[GetBuffer()->BufferSize()];
    Clear(mOutBuffer, GetBuffer()->BufferSize());
@@ -75,7 +76,8 @@ void BandVocoder::CreateUIControls()
 BandVocoder::~BandVocoder()
 {
    delete[] mCarrierInputBuffer;
-   delete[] mWorkBuffer;
+   delete[] mBandBuffer;
+   delete[] mOutBuffer;
 }
 
 void BandVocoder::SetCarrierBuffer(float* carrier, int bufferSize)
@@ -102,38 +104,40 @@ void BandVocoder::Process(double time)
 
    int bufferSize = GetBuffer()->BufferSize();
 
-   Clear(mOutBuffer, bufferSize);
-
    Mult(GetBuffer()->GetChannel(0), inputPreampSq * 5, bufferSize);
    Mult(mCarrierInputBuffer, carrierPreampSq * 5, bufferSize);
 
-   for (int i = 0; i < mNumBands; ++i)
+   int numBands = mNumBands;
+   if (mModulatorBank.GetNumFilters() != numBands)
    {
-      //get modulator band
-      BufferCopy(mWorkBuffer, GetBuffer()->GetChannel(0), bufferSize);
-      mBiquadCarrier[i].Filter(mWorkBuffer, bufferSize);
-
-      float oldPeak = mPeaks[i].GetPeak();
-
-      //calculate modulator band level
-      mPeaks[i].Process(mWorkBuffer, bufferSize);
+      mModulatorBank.SetNumFilters(numBands);
+      mCarrierBank.SetNumFilters(numBands);
+   }
 
-      //get carrier band
-      BufferCopy(mWorkBuffer, mCarrierInputBuffer, bufferSize);
-      mBiquadOut[i].Filter(mWorkBuffer, bufferSize);
+   //get modulator bands, all bands at once
+   mModulatorBank.Process(GetBuffer()->GetChannel(0), mBandBuffer, bufferSize);
 
-      //multiply carrier band by modulator band level
-      //Mult(mWorkBuffer, mPeaks[i].GetPeak(), bufferSize);
-      for (int j = 0; j < bufferSize; ++j)
-         mWorkBuffer[j] *= ofMap(j, 0, bufferSize, oldPeak, mPeaks[i].GetPeak());
+   //calculate modulator band levels
+   float peakStart[VOCODER_MAX_BANDS];
+   float peakStep[VOCODER_MAX_BANDS];
+   for (int i = 0; i < numBands; ++i)
+   {
+      peakStart[i] = mPeaks[i].GetPeak();
+      mPeaks[i].Process(mBandBuffer + i, bufferSize, numBands);
+      peakStep[i] = (mPeaks[i].GetPeak() - peakStart[i]) / bufferSize;
+   }
 
-      //don't allow a band to go crazy
-      /*mOutputPeaks[i].Process(mWorkBuffer, bufferSize);
-      if (mOutputPeaks[i].GetPeak() > mMaxBand)
-         Mult(mWorkBuffer, 1/mOutputPeaks[i].GetPeak(), bufferSize);*/
+   //get carrier bands
+   mCarrierBank.Process(mCarrierInputBuffer, mBandBuffer, bufferSize);
 
-      //accumulate output band into total output
-      Add(mOutBuffer, mWorkBuffer, bufferSize);
+   //multiply carrier bands by modulator band levels, and accumulate them into the total output
+   for (int j = 0; j < bufferSize; ++j)
+   {
+      const float* bands = mBandBuffer + j * numBands;
+      float sum = 0;
+      for (int i = 0; i < numBands; ++i)
+         sum += bands[i] * (peakStart[i] + peakStep[i] * j);
+      mOutBuffer[j] = sum;
    }
 
    Mult(mOutBuffer, mDryWet * volSq, bufferSize);
@@ -225,9 +229,9 @@ void BandVocoder::CalcFilters()
          f = ofLerp(fExp, fBass, -mSpacingStyle);
 
       mBiquadCarrier[i].SetFilterType(kFilterType_Bandpass);
-      mBiquadOut[i].SetFilterType(kFilterType_Bandpass);
       mBiquadCarrier[i].SetFilterParams(f, mQ);
-      mBiquadOut[i].CopyCoeffFrom(mBiquadCarrier[i]);
+      mModulatorBank.SetCoefficients(i, mBiquadCarrier[i]);
+      mCarrierBank.SetCoefficients(i, mBiquadCarrier[i]);
    }
 }
 
@@ -235,11 +239,8 @@ void BandVocoder::CheckboxUpdated(Checkbox* checkbox, double time)
 {
    if (checkbox == mEnabledCheckbox)
    {
-      for (int i = 0; i < VOCODER_MAX_BANDS; ++i)
-      {
-         mBiquadCarrier[i].Clear();
-         mBiquadOut[i].Clear();
-      }
+      mModulatorBank.Clear();
+      mCarrierBank.Clear();
    }
 }
 
@@ -33,6 +33,7 @@
 #include "RollingBuffer.h"
 #include "Slider.h"
 #include "BiquadFilterEffect.h"
+#include "BiquadFilterBank.h"
 #include "VocoderCarrierInput.h"
 #include "PeakTracker.h"
 
@@ -82,7 +83,7 @@ private:
 
    float* mCarrierInputBuffer{ nullptr };
 
-   float* mWorkBuffer{ nullptr };
+   float* mBandBuffer{ nullptr };
    float* mOutBuffer{ nullptr };
 
    float mInputPreamp{ 1 };
@@ -109,7 +110,8 @@ private:
    FloatSlider* mSpacingStyleSlider{ nullptr };
 
    BiquadFilter mBiquadCarrier[VOCODER_MAX_BANDS]{};
-   BiquadFilter mBiquadOut[VOCODER_MAX_BANDS]{};
+   BiquadFilterBank mModulatorBank;
+   BiquadFilterBank mCarrierBank;
    PeakTracker mPeaks[VOCODER_MAX_BANDS]{};
    PeakTracker mOutputPeaks[VOCODER_MAX_BANDS]{};
 
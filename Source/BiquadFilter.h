@@ -44,6 +44,8 @@ enum FilterType
 
 class BiquadFilter
 {
+   friend class BiquadFilterBank;
+
 public:
    BiquadFilter();
 
@@ -0,0 +1,143 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    BiquadFilterBank.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BiquadFilterBank.h"
+#include "SynthGlobals.h"
+
+#include <algorithm>
+
+void BiquadFilterBank::SetNumFilters(int numFilters)
+{
+   numFilters = std::clamp(numFilters, 0, kMaxFilters);
+   for (int i = mNumFilters; i < numFilters; ++i)
+   {
+      mZ1[i] = 0;
+      mZ2[i] = 0;
+   }
+   mNumFilters = numFilters;
+}
+
+void BiquadFilterBank::SetCoefficients(int index, const BiquadFilter& filter)
+{
+   assert(index >= 0 && index < kMaxFilters);
+   mTargetA0[index] = filter.mA0;
+   mTargetA1[index] = filter.mA1;
+   mTargetA2[index] = filter.mA2;
+   mTargetB1[index] = filter.mB1;
+   mTargetB2[index] = filter.mB2;
+}
+
+void BiquadFilterBank::Clear()
+{
+   for (int i = 0; i < kMaxFilters; ++i)
+   {
+      mZ1[i] = 0;
+      mZ2[i] = 0;
+   }
+}
+
+void BiquadFilterBank::Process(const float* input, float* output, int bufferSize)
+{
+   const int numFilters = mNumFilters;
+   if (numFilters == 0 || bufferSize <= 0)
+      return;
+
+   //work on local copies, so the compiler knows the output can't alias the filter state
+   float a0[kMaxFilters], a1[kMaxFilters], a2[kMaxFilters], b1[kMaxFilters], b2[kMaxFilters];
+   float da0[kMaxFilters], da1[kMaxFilters], da2[kMaxFilters], db1[kMaxFilters], db2[kMaxFilters];
+   float z1[kMaxFilters], z2[kMaxFilters];
+
+   //ramp linearly from the current coefficients to the targets across the buffer, to avoid zipper noise
+   //the region of stable (b1, b2) pairs is convex, so every step between two stable filters is stable too
+   const float invBufferSize = 1.0f / bufferSize;
+   bool ramping = false;
+   for (int f = 0; f < numFilters; ++f)
+   {
+      a0[f] = mA0[f];
+      a1[f] = mA1[f];
+      a2[f] = mA2[f];
+      b1[f] = mB1[f];
+      b2[f] = mB2[f];
+      da0[f] = (mTargetA0[f] - a0[f]) * invBufferSize;
+      da1[f] = (mTargetA1[f] - a1[f]) * invBufferSize;
+      da2[f] = (mTargetA2[f] - a2[f]) * invBufferSize;
+      db1[f] = (mTargetB1[f] - b1[f]) * invBufferSize;
+      db2[f] = (mTargetB2[f] - b2[f]) * invBufferSize;
+      z1[f] = mZ1[f];
+      z2[f] = mZ2[f];
+      if (da0[f] != 0 || da1[f] != 0 || da2[f] != 0 || db1[f] != 0 || db2[f] != 0)
+         ramping = true;
+   }
+
+   if (ramping)
+   {
+      for (int i = 0; i < bufferSize; ++i)
+      {
+         const float in = input[i];
+         float* out = output + i * numFilters;
+         for (int f = 0; f < numFilters; ++f)
+         {
+            a0[f] += da0[f];
+            a1[f] += da1[f];
+            a2[f] += da2[f];
+            b1[f] += db1[f];
+            b2[f] += db2[f];
+
+            const float y = in * a0[f] + z1[f];
+            z1[f] = in * a1[f] + z2[f] - b1[f] * y;
+            z2[f] = in * a2[f] - b2[f] * y;
+            out[f] = y;
+         }
+      }
+   }
+   else
+   {
+      for (int i = 0; i < bufferSize; ++i)
+      {
+         const float in = input[i];
+         float* out = output + i * numFilters;
+         for (int f = 0; f < numFilters; ++f)
+         {
+            const float y = in * a0[f] + z1[f];
+            z1[f] = in * a1[f] + z2[f] - b1[f] * y;
+            z2[f] = in * a2[f] - b2[f] * y;
+            out[f] = y;
+         }
+      }
+   }
+
+   for (int f = 0; f < numFilters; ++f)
+   {
+      //land exactly on the targets, rather than accumulating rounding error from the ramp
+      mA0[f] = mTargetA0[f];
+      mA1[f] = mTargetA1[f];
+      mA2[f] = mTargetA2[f];
+      mB1[f] = mTargetB1[f];
+      mB2[f] = mTargetB2[f];
+      mZ1[f] = z1[f];
+      mZ2[f] = z2[f];
+   }
+}
@@ -0,0 +1,63 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    BiquadFilterBank.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "BiquadFilter.h"
+
+//runs a set of independent biquads over the same input, one filter per lane, for filterbanks such as vocoders
+//uses transposed direct form II in float, with the lanes laid out contiguously so the loop across filters vectorizes
+class BiquadFilterBank
+{
+public:
+   static const int kMaxFilters = 64;
+
+   void SetNumFilters(int numFilters);
+   int GetNumFilters() const { return mNumFilters; }
+   void SetCoefficients(int index, const BiquadFilter& filter); //ramps in over the next Process() call
+   void Clear();
+
+   //output is sample-major: output[sample * GetNumFilters() + filter], and needs room for bufferSize * GetNumFilters() samples
+   void Process(const float* input, float* output, int bufferSize);
+
+private:
+   int mNumFilters{ 0 };
+
+   float mA0[kMaxFilters]{};
+   float mA1[kMaxFilters]{};
+   float mA2[kMaxFilters]{};
+   float mB1[kMaxFilters]{};
+   float mB2[kMaxFilters]{};
+
+   float mTargetA0[kMaxFilters]{};
+   float mTargetA1[kMaxFilters]{};
+   float mTargetA2[kMaxFilters]{};
+   float mTargetB1[kMaxFilters]{};
+   float mTargetB2[kMaxFilters]{};
+
+   float mZ1[kMaxFilters]{};
+   float mZ2[kMaxFilters]{};
+};
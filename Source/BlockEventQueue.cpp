@@ -0,0 +1,102 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    BlockEventQueue.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BlockEventQueue.h"
+#include "IAudioSource.h"
+#include "SynthGlobals.h"
+
+#include <cmath>
+
+BlockEventQueue::BlockEventQueue(IAudioSource* owner)
+: mOwner(owner)
+{
+}
+
+void BlockEventQueue::QueuePulse(double time, float velocity, int flags)
+{
+   BlockEvent event;
+   event.mType = BlockEvent::Type::kPulse;
+   event.mTime = time;
+   event.mVelocity = velocity;
+   event.mFlags = flags;
+   Queue(event);
+}
+
+void BlockEventQueue::QueueNote(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation)
+{
+   BlockEvent event;
+   event.mType = BlockEvent::Type::kNote;
+   event.mTime = time;
+   event.mVelocity = velocity;
+   event.mPitch = pitch;
+   event.mVoiceIdx = voiceIdx;
+   event.mModulation = modulation;
+   Queue(event);
+}
+
+void BlockEventQueue::Queue(const BlockEvent& event)
+{
+   //only the audio thread drains the queue, so anything arriving from elsewhere (ui clicks, midi input) keeps the old immediate behavior
+   if (!IsAudioThread() || mNumEvents == kMaxEvents)
+   {
+      mOwner->ApplyBlockEvent(event);
+      return;
+   }
+
+   int index = mNumEvents;
+   while (index > 0 && mEvents[index - 1].mTime > event.mTime)
+   {
+      mEvents[index] = mEvents[index - 1];
+      --index;
+   }
+   mEvents[index] = event;
+   ++mNumEvents;
+}
+
+bool BlockEventQueue::PopDue(double blockStartTime, int offset, BlockEvent& event)
+{
+   if (mNumEvents == 0 || GetOffset(mEvents[0].mTime, blockStartTime) > offset)
+      return false;
+
+   event = mEvents[0];
+   for (int i = 1; i < mNumEvents; ++i)
+      mEvents[i - 1] = mEvents[i];
+   --mNumEvents;
+   return true;
+}
+
+int BlockEventQueue::GetNextOffset(double blockStartTime) const
+{
+   if (mNumEvents == 0)
+      return gBufferSize;
+   return MAX(0, GetOffset(mEvents[0].mTime, blockStartTime));
+}
+
+//static
+int BlockEventQueue::GetOffset(double time, double blockStartTime)
+{
+   return (int)std::round((time - blockStartTime) * gSampleRateMs);
+}
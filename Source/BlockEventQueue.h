@@ -0,0 +1,70 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    BlockEventQueue.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ModulationChain.h"
+
+class IAudioSource;
+
+struct BlockEvent
+{
+   enum class Type
+   {
+      kPulse,
+      kNote
+   };
+
+   Type mType{ Type::kPulse };
+   double mTime{ 0 };
+   float mVelocity{ 0 };
+   int mFlags{ 0 };
+   int mPitch{ 0 };
+   int mVoiceIdx{ -1 };
+   ModulationParameters mModulation;
+};
+
+//timed events for a source that renders its block in spans split at event times (see IAudioSource::GetBlockEventQueue()).
+//events queued from the audio thread are held until the engine reaches their sample, anything else is applied right away
+class BlockEventQueue
+{
+public:
+   BlockEventQueue(IAudioSource* owner);
+   void QueuePulse(double time, float velocity, int flags);
+   void QueueNote(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation);
+   bool PopDue(double blockStartTime, int offset, BlockEvent& event);
+   int GetNextOffset(double blockStartTime) const;
+
+   static int GetOffset(double time, double blockStartTime);
+
+private:
+   void Queue(const BlockEvent& event);
+
+   static const int kMaxEvents = 32;
+   BlockEvent mEvents[kMaxEvents]; //sorted by time
+   int mNumEvents{ 0 };
+   IAudioSource* mOwner{ nullptr };
+};
@@ -0,0 +1,117 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    BoundedMPSCQueue.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//fixed-capacity lock-free queue that any number of threads can push into and a single thread drains.
+//each slot carries a sequence number (Vyukov's bounded queue), so pushes from one thread come out in the order they went in.
+//nothing allocates after construction, a full queue rejects the push instead of growing.
+template <class T>
+class BoundedMPSCQueue
+{
+public:
+   explicit BoundedMPSCQueue(size_t capacity)
+   : mSlots(RoundUpToPowerOfTwo(capacity))
+   , mMask(mSlots.size() - 1)
+   {
+      for (size_t i = 0; i < mSlots.size(); ++i)
+         mSlots[i].mSequence.store(i, std::memory_order_relaxed);
+   }
+
+   BoundedMPSCQueue(const BoundedMPSCQueue&) = delete;
+   BoundedMPSCQueue& operator=(const BoundedMPSCQueue&) = delete;
+
+   //any thread
+   bool TryEnqueue(const T& item)
+   {
+      size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+      Slot* slot;
+      while (true)
+      {
+         slot = &mSlots[pos & mMask];
+         size_t sequence = slot->mSequence.load(std::memory_order_acquire);
+         intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+         if (diff == 0)
+         {
+            if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+               break;
+         }
+         else if (diff < 0)
+         {
+            return false; //full
+         }
+         else
+         {
+            pos = mEnqueuePos.load(std::memory_order_relaxed);
+         }
+      }
+
+      slot->mData = item;
+      slot->mSequence.store(pos + 1, std::memory_order_release);
+      return true;
+   }
+
+   //consumer thread only
+   bool TryDequeue(T& item)
+   {
+      Slot* slot = &mSlots[mDequeuePos & mMask];
+      size_t sequence = slot->mSequence.load(std::memory_order_acquire);
+      if (sequence != mDequeuePos + 1)
+         return false; //empty, or the producer that claimed this slot hasn't finished writing it
+
+      item = slot->mData;
+      slot->mSequence.store(mDequeuePos + mMask + 1, std::memory_order_release);
+      ++mDequeuePos;
+      return true;
+   }
+
+   size_t Capacity() const { return mMask + 1; }
+
+private:
+   static size_t RoundUpToPowerOfTwo(size_t capacity)
+   {
+      size_t size = 2;
+      while (size < capacity)
+         size *= 2;
+      return size;
+   }
+
+   struct Slot
+   {
+      std::atomic<size_t> mSequence{ 0 };
+      T mData{};
+   };
+
+   std::vector<Slot> mSlots;
+   size_t mMask{ 0 };
+   alignas(64) std::atomic<size_t> mEnqueuePos{ 0 };
+   alignas(64) size_t mDequeuePos{ 0 };
+};
@@ -184,11 +184,9 @@ void BufferShuffler::Process(double time)
    }
 
    for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
-   {
-      Add(target->GetBuffer()->GetChannel(ch), GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize());
       GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize(), ch);
-   }
 
+   GetBuffer()->MixInto(target->GetBuffer(), GetBuffer()->NumActiveChannels());
    GetBuffer()->Reset();
 }
 
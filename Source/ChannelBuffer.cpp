@@ -26,6 +26,10 @@
 */
 
 #include "ChannelBuffer.h"
+#include "PeakPyramid.h"
+
+#include <cstdlib>
+#include <utility>
 
 ChannelBuffer::ChannelBuffer(int bufferSize)
 {
@@ -52,11 +56,32 @@ ChannelBuffer::~ChannelBuffer()
    if (mOwnsBuffers)
    {
       for (int i = 0; i < mNumChannels; ++i)
-         delete[] mBuffers[i];
+         ReleaseChannel(i);
    }
    delete[] mBuffers;
 }
 
+//static
+float* ChannelBuffer::AllocateChannel(int bufferSize)
+{
+   return static_cast<float*>(std::calloc(bufferSize, sizeof(float)));
+}
+
+//static
+void ChannelBuffer::FreeChannel(float* data)
+{
+   std::free(data);
+}
+
+void ChannelBuffer::ReleaseChannel(int channel)
+{
+   if (IsMapped(channel))
+      mMappings[channel].reset();
+   else
+      FreeChannel(mBuffers[channel]);
+   mBuffers[channel] = nullptr;
+}
+
 void ChannelBuffer::Setup(int bufferSize)
 {
    mBuffers = new float*[mNumChannels];
@@ -72,24 +97,49 @@ float* ChannelBuffer::GetChannel(int channel)
 {
    if (channel >= mActiveChannels)
       ofLog() << "error: requesting a higher channel index than we have active";
-   float* ret = mBuffers[MIN(channel, mActiveChannels - 1)];
+   int index = MIN(channel, mActiveChannels - 1);
+   float* ret = mBuffers[index];
    if (ret == nullptr)
    {
       assert(mOwnsBuffers);
-      ret = new float[BufferSize()];
-      ::Clear(ret, BufferSize());
-      mBuffers[MIN(channel, mActiveChannels - 1)] = ret;
+      ret = AllocateChannel(BufferSize());
+      mBuffers[index] = ret;
    }
+   SetChannelClear(index, false); //the caller may write to it
    return ret;
 }
 
+void ChannelBuffer::SetChannelClear(int channel, bool clear) const
+{
+   if (!mOwnsBuffers || channel >= kMaxNumChannels)
+      return;
+   unsigned int bit = 1u << channel;
+   if (clear)
+      mClearChannels.fetch_or(bit, std::memory_order_relaxed);
+   else if (mClearChannels.load(std::memory_order_relaxed) & bit) //GetChannel() is hot, so only pay for the read-modify-write when the bit changes
+      mClearChannels.fetch_and(~bit, std::memory_order_relaxed);
+}
+
 void ChannelBuffer::Clear() const
 {
    for (int i = 0; i < mNumChannels; ++i)
    {
-      if (mBuffers[i] != nullptr)
+      if (mBuffers[i] != nullptr && !IsChannelClear(i)) //nothing has touched it since the last clear, which is common for input buffers that are cleared after every block
          ::Clear(mBuffers[i], BufferSize());
+      SetChannelClear(i, true);
    }
+   InvalidatePeaks();
+}
+
+void ChannelBuffer::Clear(int length) const
+{
+   assert(length <= mBufferSize);
+   for (int i = 0; i < mNumChannels; ++i)
+   {
+      if (mBuffers[i] != nullptr)
+         ::Clear(mBuffers[i], length);
+   }
+   MarkWritten(0, length);
 }
 
 void ChannelBuffer::SetMaxAllowedChannels(int channels)
@@ -104,7 +154,7 @@ void ChannelBuffer::SetMaxAllowedChannels(int channels)
    }
 
    for (int i = channels; i < mNumChannels; ++i)
-      delete[] mBuffers[i];
+      ReleaseChannel(i);
    delete[] mBuffers;
 
    mBuffers = newBuffers;
@@ -122,36 +172,97 @@ void ChannelBuffer::CopyFrom(ChannelBuffer* src, int length /*= -1*/, int startO
    mActiveChannels = src->mActiveChannels;
    for (int i = 0; i < mActiveChannels; ++i)
    {
+      SetChannelClear(i, false);
       if (src->mBuffers[i])
       {
          if (mBuffers[i] == nullptr)
          {
             assert(mOwnsBuffers);
-            mBuffers[i] = new float[mBufferSize];
-            ::Clear(mBuffers[i], mBufferSize);
+            mBuffers[i] = AllocateChannel(mBufferSize);
          }
          BufferCopy(mBuffers[i], src->mBuffers[i] + startOffset, length);
       }
       else
       {
-         delete mBuffers[i];
-         mBuffers[i] = nullptr;
+         ReleaseChannel(i);
       }
    }
+   MarkWritten(0, length);
 }
 
 void ChannelBuffer::SetChannelPointer(float* data, int channel, bool deleteOldData)
 {
+   assert(deleteOldData || !IsMapped(channel)); //a mapped channel can't be handed off
    if (deleteOldData)
-      delete[] mBuffers[channel];
+      ReleaseChannel(channel);
    mBuffers[channel] = data;
+   SetChannelClear(channel, false);
+   InvalidatePeaks();
+}
+
+bool ChannelBuffer::CanExchangeChannel(const ChannelBuffer* dest, int channel) const
+{
+   return mOwnsBuffers && dest->mOwnsBuffers &&
+          mBufferSize == dest->mBufferSize &&
+          channel < mActiveChannels && channel < dest->mActiveChannels &&
+          mBuffers[channel] != nullptr && dest->mBuffers[channel] != nullptr && //don't leave either side to allocate on the audio thread
+          !IsMapped(channel) && !dest->IsMapped(channel) &&
+          mPeakPyramids[channel] == nullptr && dest->mPeakPyramids[channel] == nullptr &&
+          dest->IsChannelClear(channel);
+}
+
+void ChannelBuffer::MixInto(ChannelBuffer* dest, int numChannels)
+{
+   //a receiver with a single upstream source gets that source's channel memory handed over rather than summed into its own, and hands back its zeroed memory,
+   //so a linear chain of effects moves the audio along by pointer. fan-in still sums, since only the first channel to arrive in a block finds dest clear
+   dest->SetNumActiveChannels(MAX(numChannels, dest->NumActiveChannels()));
+   for (int ch = 0; ch < numChannels; ++ch)
+   {
+      if (CanExchangeChannel(dest, ch))
+      {
+         std::swap(mBuffers[ch], dest->mBuffers[ch]);
+         SetChannelClear(ch, true);
+         dest->SetChannelClear(ch, false);
+      }
+      else
+      {
+         Add(dest->GetChannel(ch), GetChannel(ch), mBufferSize);
+      }
+   }
+}
+
+void ChannelBuffer::EnablePeakPyramid()
+{
+   for (int i = 0; i < kMaxNumChannels; ++i)
+   {
+      if (mPeakPyramids[i] == nullptr)
+         mPeakPyramids[i] = std::make_unique<PeakPyramid>();
+   }
+}
+
+void ChannelBuffer::MarkWritten(int start, int length) const
+{
+   for (const auto& pyramid : mPeakPyramids)
+   {
+      if (pyramid != nullptr)
+         pyramid->MarkWritten(start, length);
+   }
+}
+
+void ChannelBuffer::InvalidatePeaks() const
+{
+   for (const auto& pyramid : mPeakPyramids)
+   {
+      if (pyramid != nullptr)
+         pyramid->Invalidate();
+   }
 }
 
 void ChannelBuffer::Resize(int bufferSize)
 {
    assert(mOwnsBuffers);
    for (int i = 0; i < mNumChannels; ++i)
-      delete[] mBuffers[i];
+      ReleaseChannel(i);
    delete[] mBuffers;
 
    Setup(bufferSize);
@@ -159,7 +270,7 @@ void ChannelBuffer::Resize(int bufferSize)
 
 namespace
 {
-   const int kSaveStateRev = 1;
+   const int kSaveStateRev = 2;
 }
 
 void ChannelBuffer::Save(FileStreamOut& out, int writeLength)
@@ -173,7 +284,10 @@ void ChannelBuffer::Save(FileStreamOut& out, int writeLength)
       bool hasBuffer = mBuffers[i] != nullptr;
       out << hasBuffer;
       if (hasBuffer)
+      {
+         out.WriteAlignmentPadding(sizeof(float)); //lets Load() map the data
          out.Write(mBuffers[i], writeLength);
+      }
    }
 }
 
@@ -185,7 +299,7 @@ void ChannelBuffer::Load(FileStreamIn& in, int& readLength, LoadMode loadMode)
 
    in >> readLength;
    if (loadMode == LoadMode::kSetBufferSize)
-      Setup(readLength);
+      Resize(readLength);
    else if (loadMode == LoadMode::kRequireExactBufferSize)
       assert(readLength == mBufferSize);
    else
@@ -198,6 +312,28 @@ void ChannelBuffer::Load(FileStreamIn& in, int& readLength, LoadMode loadMode)
          in >> hasBuffer;
 
       if (hasBuffer)
-         in.Read(GetChannel(i), readLength);
+      {
+         if (rev >= 2)
+            in.SkipAlignmentPadding();
+
+         //long buffers that fill the whole channel are mapped straight from the file, and only get private copies of the pages that are written to
+         float* mappedData = nullptr;
+         std::unique_ptr<juce::MemoryMappedFile> mapping;
+         if (readLength == mBufferSize && readLength >= kMinMappedLength && i < kMaxNumChannels && mOwnsBuffers)
+            mapping = in.MapFloats(readLength, mappedData);
+
+         if (mapping != nullptr)
+         {
+            ReleaseChannel(i);
+            mBuffers[i] = mappedData;
+            mMappings[i] = std::move(mapping);
+         }
+         else
+         {
+            in.Read(GetChannel(i), readLength);
+         }
+      }
    }
+   mClearChannels = 0;
+   InvalidatePeaks();
 }
@@ -29,6 +29,12 @@
 #include "SynthGlobals.h"
 #include "FileStream.h"
 
+#include <array>
+#include <atomic>
+#include <memory>
+
+class PeakPyramid;
+
 class ChannelBuffer
 {
 public:
@@ -39,6 +45,7 @@ public:
    float* GetChannel(int channel);
 
    void Clear() const;
+   void Clear(int length) const;
 
    void SetMaxAllowedChannels(int channels);
    void SetNumActiveChannels(int channels) { mActiveChannels = MIN(mNumChannels, channels); }
@@ -47,7 +54,8 @@ public:
    int NumTotalChannels() const { return mNumChannels; }
    int BufferSize() const { return mBufferSize; }
    void CopyFrom(ChannelBuffer* src, int length = -1, int startOffset = 0);
-   void SetChannelPointer(float* data, int channel, bool deleteOldData);
+   void MixInto(ChannelBuffer* dest, int numChannels); //leaves our mixed channels with undefined contents
+   void SetChannelPointer(float* data, int channel, bool deleteOldData); //data must come from AllocateChannel()
    void Reset()
    {
       Clear();
@@ -67,9 +75,26 @@ public:
    void Load(FileStreamIn& in, int& readLength, LoadMode loadMode);
 
    static const int kMaxNumChannels = 2;
+   static const int kMinMappedLength = 1 << 18; //loads at least this long map the saved data rather than copying it
+
+   bool IsMapped(int channel) const { return channel < kMaxNumChannels && mMappings[channel] != nullptr; }
+
+   //keep peak summaries of the contents for drawing. owners that write through GetChannel() must report it with MarkWritten() or InvalidatePeaks()
+   void EnablePeakPyramid();
+   PeakPyramid* GetPeakPyramid(int channel) const { return channel < kMaxNumChannels ? mPeakPyramids[channel].get() : nullptr; }
+   void MarkWritten(int start, int length) const;
+   void InvalidatePeaks() const;
+
+   //zeroed by the allocator, so the OS only commits pages of long buffers as they get touched
+   static float* AllocateChannel(int bufferSize);
+   static void FreeChannel(float* data);
 
 private:
    void Setup(int bufferSize);
+   void ReleaseChannel(int channel);
+   bool CanExchangeChannel(const ChannelBuffer* dest, int channel) const;
+   void SetChannelClear(int channel, bool clear) const;
+   bool IsChannelClear(int channel) const { return channel < kMaxNumChannels && (mClearChannels.load(std::memory_order_relaxed) & (1u << channel)) != 0; }
 
    int mActiveChannels{ 1 };
    int mNumChannels{ 1 };
@@ -77,4 +102,7 @@ private:
    float** mBuffers;
    int mRecentActiveChannels{ 1 };
    bool mOwnsBuffers{ true };
+   std::array<std::unique_ptr<juce::MemoryMappedFile>, kMaxNumChannels> mMappings; //set for channels that point into a mapped file rather than memory from AllocateChannel()
+   std::array<std::unique_ptr<PeakPyramid>, kMaxNumChannels> mPeakPyramids;
+   mutable std::atomic<unsigned int> mClearChannels{ 0 }; //bit per channel that is known to hold only zeros. only tracked when we own the memory, since otherwise it can be written behind our back
 };
@@ -220,6 +220,29 @@ void Chorder::PlayNote(double time, int pitch, int velocity, int voiceIdx, Modul
       return;
    }
 
+   NoteBatch batch;
+   PlayChord(time, pitch, velocity, voiceIdx, modulation, batch);
+   PlayNotesOutput(batch);
+   CheckLeftovers();
+}
+
+void Chorder::PlayNotes(const NoteEvent* notes, int count)
+{
+   if (!mEnabled)
+   {
+      PlayNotesOutput(notes, count);
+      return;
+   }
+
+   NoteBatch batch;
+   for (int i = 0; i < count; ++i)
+      PlayChord(notes[i].time, notes[i].pitch, notes[i].velocity, notes[i].voiceIdx, notes[i].modulation, batch);
+   PlayNotesOutput(batch);
+   CheckLeftovers();
+}
+
+void Chorder::PlayChord(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation, NoteBatch& batch)
+{
    bool noteOn = velocity > 0;
    if (mInputNotes[pitch] == noteOn)
       return;
@@ -258,16 +281,15 @@ void Chorder::PlayNote(double time, int pitch, int velocity, int voiceIdx, Modul
                outPitch = TheScale->MakeDiatonic(TheScale->GetPitchFromTone(tone));
             }
 
-            PlayChorderNote(time, outPitch, velocity * val * val, voice, modulation);
+            PlayChorderNote(time, outPitch, velocity * val * val, voice, modulation, &batch);
 
             ++idx;
          }
       }
    }
-   CheckLeftovers();
 }
 
-void Chorder::PlayChorderNote(double time, int pitch, int velocity, int voice /*=-1*/, ModulationParameters modulation)
+void Chorder::PlayChorderNote(double time, int pitch, int velocity, int voice /*=-1*/, ModulationParameters modulation, NoteBatch* batch /*=nullptr*/)
 {
    assert(velocity >= 0);
 
@@ -282,10 +304,28 @@ void Chorder::PlayChorderNote(double time, int pitch, int velocity, int voice /*
    if (velocity == 0 && mHeldCount[pitch] > 0)
       --mHeldCount[pitch];
 
+   int outputVelocity;
    if (mHeldCount[pitch] > 0 && !wasOn)
-      PlayNoteOutput(time, pitch, velocity, voice, modulation);
-   if (mHeldCount[pitch] == 0 && wasOn)
-      PlayNoteOutput(time, pitch, 0, voice, modulation);
+      outputVelocity = velocity;
+   else if (mHeldCount[pitch] == 0 && wasOn)
+      outputVelocity = 0;
+   else
+      return;
+
+   if (batch != nullptr)
+   {
+      NoteEvent note;
+      note.time = time;
+      note.pitch = pitch;
+      note.velocity = outputVelocity;
+      note.voiceIdx = voice;
+      note.modulation = modulation;
+      AddToNoteBatch(*batch, note);
+   }
+   else
+   {
+      PlayNoteOutput(time, pitch, outputVelocity, voice, modulation);
+   }
 
    //ofLog() << ofToString(pitch) + " " + ofToString(velocity) + ": " + ofToString(mHeldCount[pitch]) + " " + ofToString(voice);
 }
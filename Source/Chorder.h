@@ -53,6 +53,7 @@ public:
 
    //INoteReceiver
    void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) override;
+   void PlayNotes(const NoteEvent* notes, int count) override;
 
    void GridUpdated(UIGrid* grid, int col, int row, float value, float oldValue) override;
 
@@ -82,7 +83,8 @@ private:
    void MouseReleased() override;
    bool MouseMoved(float x, float y) override;
 
-   void PlayChorderNote(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation);
+   void PlayChord(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation, NoteBatch& batch);
+   void PlayChorderNote(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation, NoteBatch* batch = nullptr);
    void CheckLeftovers();
    void SyncChord();
 
@@ -0,0 +1,108 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    CpuGovernor.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "CpuGovernor.h"
+#include "SynthGlobals.h"
+#include "UserPrefs.h"
+
+std::chrono::steady_clock::time_point CpuGovernor::sBlockStart;
+float CpuGovernor::sSmoothedLoad = 0;
+int CpuGovernor::sBlocksOverBudget = 0;
+double CpuGovernor::sMsUnderBudget = 0;
+std::atomic<CpuGovernor::Quality> CpuGovernor::sQuality{ CpuGovernor::Quality::kFull };
+CpuGovernor::Quality CpuGovernor::sLoggedQuality = CpuGovernor::Quality::kFull;
+
+//static
+void CpuGovernor::BeginBlock()
+{
+   sBlockStart = std::chrono::steady_clock::now();
+}
+
+//static
+void CpuGovernor::EndBlock(double deadlineMs)
+{
+   double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sBlockStart).count();
+   float load = deadlineMs > 0 ? float(elapsedMs / deadlineMs) : 0;
+   sSmoothedLoad = sSmoothedLoad * .9f + load * .1f;
+
+   if (!UserPrefs.adaptive_cpu_quality.Get())
+   {
+      sQuality.store(Quality::kFull, std::memory_order_relaxed);
+      sBlocksOverBudget = 0;
+      sMsUnderBudget = 0;
+      return;
+   }
+
+   Quality quality = GetQuality();
+   if (sSmoothedLoad > kTightLoad)
+   {
+      sMsUnderBudget = 0;
+      ++sBlocksOverBudget;
+      if (sBlocksOverBudget >= kBlocksBeforeReducing && quality != Quality::kReducedUnison)
+      {
+         sQuality.store(Quality(int(quality) + 1), std::memory_order_relaxed);
+         sBlocksOverBudget = 0;
+      }
+   }
+   else if (sSmoothedLoad < kRelaxedLoad)
+   {
+      sBlocksOverBudget = 0;
+      sMsUnderBudget += deadlineMs;
+      if (sMsUnderBudget >= kMsBeforeRestoring && quality != Quality::kFull)
+      {
+         sQuality.store(Quality(int(quality) - 1), std::memory_order_relaxed);
+         sMsUnderBudget = 0;
+      }
+   }
+   else
+   {
+      sBlocksOverBudget = 0;
+      sMsUnderBudget = 0;
+   }
+}
+
+//static
+void CpuGovernor::Poll()
+{
+   Quality quality = GetQuality();
+   if (quality != sLoggedQuality)
+   {
+      ofLog() << "cpu governor: " << (quality > sLoggedQuality ? "reducing" : "restoring") << " quality to \"" << GetQualityName(quality) << "\" (load " << ofToString(sSmoothedLoad * 100, 0) << "%)";
+      sLoggedQuality = quality;
+   }
+}
+
+//static
+const char* CpuGovernor::GetQualityName(Quality quality)
+{
+   switch (quality)
+   {
+      case Quality::kFull: return "full";
+      case Quality::kBlockRateParameters: return "block rate parameters";
+      case Quality::kReducedUnison: return "reduced unison";
+   }
+   return "";
+}
@@ -0,0 +1,67 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    CpuGovernor.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+//watches how long each rendered engine block takes against its share of real time, and steps down the quality of modules that support it when the budget gets tight.
+//quality is stepped back up once there has been headroom for a while.
+class CpuGovernor
+{
+public:
+   enum class Quality
+   {
+      kFull,
+      kBlockRateParameters, //voices compute their parameters once per block, like "lite cpu" mode
+      kReducedUnison //voices also play fewer unison oscillators
+   };
+
+   static void BeginBlock();
+   static void EndBlock(double deadlineMs);
+   static void Poll(); //main thread, logs quality changes
+
+   static Quality GetQuality() { return sQuality.load(std::memory_order_relaxed); }
+   static bool UseBlockRateParameters() { return GetQuality() >= Quality::kBlockRateParameters; }
+   static int GetUnison(int unison) { return GetQuality() >= Quality::kReducedUnison ? (unison + 1) / 2 : unison; }
+   static float GetSmoothedLoad() { return sSmoothedLoad; }
+
+private:
+   static const char* GetQualityName(Quality quality);
+
+   static constexpr float kTightLoad = .8f; //step quality down when the smoothed load stays above this
+   static constexpr float kRelaxedLoad = .5f; //step quality up when the smoothed load stays below this
+   static constexpr int kBlocksBeforeReducing = 8;
+   static constexpr double kMsBeforeRestoring = 3000;
+
+   static std::chrono::steady_clock::time_point sBlockStart;
+   static float sSmoothedLoad;
+   static int sBlocksOverBudget;
+   static double sMsUnderBudget;
+   static std::atomic<Quality> sQuality;
+   static Quality sLoggedQuality;
+};
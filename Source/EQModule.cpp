@@ -195,11 +195,8 @@ void EQModule::Process(double time)
    else //passthrough
    {
       for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
-      {
-         float* buffer = GetBuffer()->GetChannel(ch);
-         Add(target->GetBuffer()->GetChannel(ch), buffer, GetBuffer()->BufferSize());
-         GetVizBuffer()->WriteChunk(buffer, GetBuffer()->BufferSize(), ch);
-      }
+         GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize(), ch);
+      GetBuffer()->MixInto(target->GetBuffer(), GetBuffer()->NumActiveChannels());
    }
 
    GetBuffer()->Reset();
@@ -164,10 +164,10 @@ void EffectChain::Process(double time)
       float volSq = mVolume * mVolume;
       for (int i = 0; i < bufferSize; ++i)
          buffer[i] *= volSq;
-      Add(target->GetBuffer()->GetChannel(ch), buffer, bufferSize);
       GetVizBuffer()->WriteChunk(buffer, bufferSize, ch);
    }
 
+   GetBuffer()->MixInto(target->GetBuffer(), GetBuffer()->NumActiveChannels());
    GetBuffer()->Reset();
 }
 
@@ -0,0 +1,99 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    ExpressionCurve.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ExpressionCurve.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+   std::string ToLower(std::string str)
+   {
+      std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+      return str;
+   }
+}
+
+bool ExpressionCurve::Compile(const std::string& text, exprtk::expression<float>& expression)
+{
+   using parser_t = exprtk::parser<float>;
+
+   mReadVariables.clear();
+   mHasAssignments = false;
+   Invalidate();
+
+   parser_t parser;
+   parser.dec().collect_variables() = true;
+   parser.dec().collect_assignments() = true;
+   if (!parser.compile(text, expression))
+      return false;
+
+   std::vector<parser_t::dependent_entity_collector::symbol_t> symbols;
+   parser.dec().symbols(symbols);
+   for (const auto& symbol : symbols)
+      mReadVariables.push_back(ToLower(symbol.first));
+
+   symbols.clear();
+   parser.dec().assignment_symbols(symbols);
+   mHasAssignments = !symbols.empty();
+
+   return true;
+}
+
+bool ExpressionCurve::Reads(const std::string& variable) const
+{
+   return std::find(mReadVariables.begin(), mReadVariables.end(), ToLower(variable)) != mReadVariables.end();
+}
+
+void ExpressionCurve::Bake(exprtk::expression<float>& expression, float& input, const Params& params)
+{
+   Table& table = (mPublishedTable == &mTables[0]) ? mTables[1] : mTables[0];
+   table.mParams = params;
+   table.mUsable = true;
+   for (int i = 0; i <= kTableSize; ++i)
+   {
+      input = -kRange + i * (2 * kRange / kTableSize);
+      table.mValues[i] = expression.value();
+      if (!std::isfinite(table.mValues[i])) //interpolating across a pole would smear it into its neighbours
+         table.mUsable = false;
+   }
+   mPublishedTable = &table;
+}
+
+bool ExpressionCurve::NeedsBake(const Params& params) const
+{
+   const Table* table = mPublishedTable;
+   return table == nullptr || table->mParams != params;
+}
+
+const ExpressionCurve::Table* ExpressionCurve::GetTable(const Params& params) const
+{
+   const Table* table = mPublishedTable;
+   if (table == nullptr || !table->mUsable || table->mParams != params)
+      return nullptr;
+   return table;
+}
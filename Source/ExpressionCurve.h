@@ -0,0 +1,75 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    ExpressionCurve.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "exprtk/exprtk.hpp"
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+//compiles an exprtk expression while noting which variables it reads, so callers can skip per-sample setup the expression doesn't need.
+//an expression that is a pure function of its input can be baked into a table and applied without going through the interpreter.
+class ExpressionCurve
+{
+public:
+   static constexpr int kTableSize = 4096;
+   static constexpr float kRange = 4;
+   using Params = std::array<float, 5>; //the parameter values a table was baked with
+
+   struct Table
+   {
+      bool InRange(float x) const { return x > -kRange && x < kRange; }
+      float Lookup(float x) const
+      {
+         float pos = (x + kRange) * (kTableSize / (2 * kRange));
+         int index = (int)pos;
+         float a = mValues[index];
+         return a + (mValues[index + 1] - a) * (pos - index);
+      }
+
+      std::array<float, kTableSize + 1> mValues{};
+      Params mParams{};
+      bool mUsable{ false };
+   };
+
+   bool Compile(const std::string& text, exprtk::expression<float>& expression);
+   bool Reads(const std::string& variable) const;
+   bool HasAssignments() const { return mHasAssignments; }
+
+   //evaluates the whole curve, so keep this off the audio thread. expression must not be one the audio thread evaluates.
+   void Bake(exprtk::expression<float>& expression, float& input, const Params& params);
+   void Invalidate() { mPublishedTable = nullptr; }
+   bool NeedsBake(const Params& params) const;
+   const Table* GetTable(const Params& params) const; //nullptr unless a usable table was baked with these params
+
+private:
+   std::vector<std::string> mReadVariables; //lower case, exprtk symbols are case insensitive
+   bool mHasAssignments{ false };
+   Table mTables[2]; //double-buffered so the audio thread never reads a table being baked
+   std::atomic<const Table*> mPublishedTable{ nullptr };
+};
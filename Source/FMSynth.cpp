@@ -139,10 +139,8 @@ void FMSynth::Process(double time)
 
    SyncOutputBuffer(mWriteBuffer.NumActiveChannels());
    for (int ch = 0; ch < mWriteBuffer.NumActiveChannels(); ++ch)
-   {
       GetVizBuffer()->WriteChunk(mWriteBuffer.GetChannel(ch), mWriteBuffer.BufferSize(), ch);
-      Add(target->GetBuffer()->GetChannel(ch), mWriteBuffer.GetChannel(ch), gBufferSize);
-   }
+   mWriteBuffer.MixInto(target->GetBuffer(), mWriteBuffer.NumActiveChannels());
 }
 
 void FMSynth::PlayNote(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation)
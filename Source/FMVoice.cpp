@@ -57,6 +57,12 @@ bool FMVoice::Process(double time, ChannelBuffer* out, int oversampling)
    double sampleIncrementMs = gInvSampleRateMs;
    ChannelBuffer* destBuffer = out;
 
+   //pitch only changes once per output sample, so convert the whole block up front
+   float* oscFreqs = gWorkBuffer;
+   for (int i = 0; i < bufferSize; ++i)
+      oscFreqs[i] = GetPitch(i);
+   TheScale->PitchToFreq(oscFreqs, oscFreqs, bufferSize);
+
    if (oversampling != 1)
    {
       gMidiVoiceWorkChannelBuffer.SetNumActiveChannels(channels);
@@ -71,7 +77,7 @@ bool FMVoice::Process(double time, ChannelBuffer* out, int oversampling)
       if (mOwner)
          mOwner->ComputeSliders(pos / oversampling);
 
-      float oscFreq = TheScale->PitchToFreq(GetPitch(pos / oversampling));
+      float oscFreq = oscFreqs[pos / oversampling];
       float harmFreq = oscFreq * mHarm.GetADSR()->Value(time) * mVoiceParams->mHarmRatio;
       float harmFreq2 = harmFreq * mHarm2.GetADSR()->Value(time) * mVoiceParams->mHarmRatio2;
 
@@ -26,11 +26,54 @@
 #include "FileStream.h"
 #include "ModularSynth.h"
 
+#include <cstring>
+
+#if !JUCE_WINDOWS
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 //static
 bool FileStreamIn::s32BitMode = false;
 
+namespace
+{
+   //chunked save files start with this instead of the length of the layout json, which is always far smaller than these bytes read as a number
+   const char kChunkedFileMagic[8] = { 'B', 'S', 'K', 'C', 'H', 'U', 'N', 'K' };
+   const char kChunkedFileFooterMagic[8] = { 'B', 'S', 'K', 'C', 'H', 'T', 'O', 'C' };
+   const int kChunkedFileRev = 1;
+
+   //standard crc-32 (as used by zip and png)
+   struct Crc32Table
+   {
+      Crc32Table()
+      {
+         for (uint32_t i = 0; i < 256; ++i)
+         {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+               crc = (crc & 1) ? (0xEDB88320u ^ (crc >> 1)) : (crc >> 1);
+            mValues[i] = crc;
+         }
+      }
+      uint32_t mValues[256];
+   };
+   const Crc32Table kCrc32Table;
+
+   uint32_t UpdateCrc32(uint32_t crc, const void* data, size_t size)
+   {
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      crc = ~crc;
+      for (size_t i = 0; i < size; ++i)
+         crc = kCrc32Table.mValues[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+      return ~crc;
+   }
+}
+
 FileStreamOut::FileStreamOut(const std::string& file)
-: mStream(std::make_unique<juce::FileOutputStream>(juce::File{ file }))
+//write next to the target and swap it in when done, so buffers that are still mapped from the old file (see FileStreamIn::MapFloats()) keep their data
+: mTempFile(std::make_unique<juce::TemporaryFile>(juce::File{ file }))
+, mStream(std::make_unique<juce::FileOutputStream>(mTempFile->getFile(), kWriteBufferSize))
 {
    mStream->setPosition(0);
    mStream->truncate();
@@ -39,67 +82,86 @@ FileStreamOut::FileStreamOut(const std::string& file)
 FileStreamOut::~FileStreamOut()
 {
    mStream->flush();
+   bool ok = mStream->openedOk() && mStream->getStatus().wasOk();
+   mStream.reset();
+   if (ok)
+      ok = mTempFile->overwriteTargetFileWithTemporary();
+   if (!ok && TheSynth != nullptr)
+      TheSynth->LogEvent("couldn't write " + mTempFile->getTargetFile().getFullPathName().toStdString(), kLogEventType_Error);
 }
 
 FileStreamIn::FileStreamIn(const std::string& file)
-: mStream(std::make_unique<juce::FileInputStream>(juce::File{ file }))
+: mFile(file)
 {
+   //juce::FileInputStream goes to the OS for every read, and save states are mostly made of tiny reads, so buffer them
+   auto fileStream = std::make_unique<juce::FileInputStream>(mFile);
+   mOpenedOk = fileStream->openedOk();
+   mStream = std::make_unique<juce::BufferedInputStream>(fileStream.release(), kReadBufferSize, true);
 }
 
 FileStreamIn::~FileStreamIn() = default;
 
 FileStreamOut& FileStreamOut::operator<<(const int& var)
 {
-   mStream->write(&var, sizeof(int));
+   WriteBytes(&var, sizeof(int));
    return *this;
 }
 
 FileStreamOut& FileStreamOut::operator<<(const uint32_t& var)
 {
-   mStream->write(&var, sizeof(uint32_t));
+   WriteBytes(&var, sizeof(uint32_t));
    return *this;
 }
 
 FileStreamOut& FileStreamOut::operator<<(const bool& var)
 {
-   mStream->write(&var, sizeof(bool));
+   WriteBytes(&var, sizeof(bool));
    return *this;
 }
 
 FileStreamOut& FileStreamOut::operator<<(const float& var)
 {
-   mStream->write(&var, sizeof(float));
+   WriteBytes(&var, sizeof(float));
    return *this;
 }
 
 FileStreamOut& FileStreamOut::operator<<(const double& var)
 {
-   mStream->write(&var, sizeof(double));
+   WriteBytes(&var, sizeof(double));
    return *this;
 }
 
 FileStreamOut& FileStreamOut::operator<<(const std::string& var)
 {
    const uint64_t len = var.length();
-   mStream->write(&len, sizeof(len));
-   mStream->write(var.data(), len);
+   WriteBytes(&len, sizeof(len));
+   WriteBytes(var.data(), len);
    return *this;
 }
 
 FileStreamOut& FileStreamOut::operator<<(const char& var)
 {
-   mStream->write(&var, sizeof(char));
+   WriteBytes(&var, sizeof(char));
    return *this;
 }
 
 void FileStreamOut::Write(const float* buffer, int size)
 {
-   mStream->write(buffer, sizeof(float) * size);
+   WriteBytes(buffer, sizeof(float) * size);
 }
 
 void FileStreamOut::WriteGeneric(const void* buffer, int size)
 {
-   mStream->write(buffer, size);
+   WriteBytes(buffer, size);
+}
+
+//writes a pad length followed by that many zero bytes, so that whatever is written next starts at a multiple of alignment in the file
+void FileStreamOut::WriteAlignmentPadding(int alignment)
+{
+   char padding = char((alignment - (GetSize() + 1) % alignment) % alignment);
+   *this << padding;
+   for (int i = 0; i < padding; ++i)
+      *this << char(0);
 }
 
 juce::int64 FileStreamOut::GetSize() const
@@ -107,6 +169,60 @@ juce::int64 FileStreamOut::GetSize() const
    return mStream->getPosition();
 }
 
+void FileStreamOut::WriteBytes(const void* buffer, size_t size)
+{
+   if (mInChunk)
+      mChunks.back().mChecksum = UpdateCrc32(mChunks.back().mChecksum, buffer, size);
+   mStream->write(buffer, size);
+}
+
+//chunked files are the same stream as before, with a header in front and a table of contents after.
+//the table lists where each chunk (the layout, and each top-level module) starts and ends, along with a checksum of its bytes.
+void FileStreamOut::BeginChunkedFile()
+{
+   assert(GetSize() == 0);
+   WriteGeneric(kChunkedFileMagic, sizeof(kChunkedFileMagic));
+   *this << kChunkedFileRev;
+   mChunkedFile = true;
+}
+
+bool FileStreamOut::BeginChunk(const std::string& name)
+{
+   if (!mChunkedFile || mInChunk)
+      return false;
+
+   FileStreamChunk chunk;
+   chunk.mName = name;
+   chunk.mOffset = GetSize();
+   mChunks.push_back(chunk);
+   mInChunk = true;
+   return true;
+}
+
+void FileStreamOut::EndChunk()
+{
+   assert(mInChunk);
+   mChunks.back().mLength = GetSize() - mChunks.back().mOffset;
+   mInChunk = false;
+}
+
+void FileStreamOut::EndChunkedFile()
+{
+   assert(mChunkedFile && !mInChunk);
+   juce::int64 tocOffset = GetSize();
+   *this << (int)mChunks.size();
+   for (const auto& chunk : mChunks)
+   {
+      *this << chunk.mName;
+      WriteGeneric(&chunk.mOffset, sizeof(chunk.mOffset));
+      WriteGeneric(&chunk.mLength, sizeof(chunk.mLength));
+      *this << chunk.mChecksum;
+   }
+   WriteGeneric(&tocOffset, sizeof(tocOffset));
+   WriteGeneric(kChunkedFileFooterMagic, sizeof(kChunkedFileFooterMagic));
+   mChunkedFile = false;
+}
+
 FileStreamIn& FileStreamIn::operator>>(int& var)
 {
    mStream->read(&var, sizeof(int));
@@ -172,11 +288,141 @@ void FileStreamIn::Read(float* buffer, int size)
    mStream->read(buffer, sizeof(float) * size);
 }
 
+//maps the next size floats of the file instead of reading them, and skips past them. returns nullptr and leaves the position alone if they can't be mapped.
+//the mapping is private, so pages are shared with the page cache (and other processes) until something writes to them.
+//data must start at a multiple of sizeof(float) in the file, see FileStreamOut::WriteAlignmentPadding().
+//the file must not be truncated in place while it is mapped: reading a page past the new end raises SIGBUS, most likely on the audio thread.
+//FileStreamOut replaces files by renaming a new one over them, which is safe, the mapping keeps the old file's data alive.
+std::unique_ptr<juce::MemoryMappedFile> FileStreamIn::MapFloats(int size, float*& data)
+{
+#if JUCE_WINDOWS
+   //windows won't let FileStreamOut replace a file that is mapped
+   return nullptr;
+#else
+   juce::int64 start = mStream->getPosition();
+   juce::int64 numBytes = juce::int64(size) * sizeof(float);
+   if (start % sizeof(float) != 0)
+      return nullptr;
+
+   //an exclusive mapping is MAP_PRIVATE, so writes copy the touched pages and never reach the file.
+   //map it read-only (which only needs the file opened O_RDONLY, so read-only session files work) and then make the private pages writable.
+   auto mapping = std::make_unique<juce::MemoryMappedFile>(mFile, juce::Range<juce::int64>(start, start + numBytes), juce::MemoryMappedFile::readOnly, true);
+   if (mapping->getData() == nullptr || mapping->getRange().getStart() > start || mapping->getRange().getEnd() < start + numBytes)
+      return nullptr;
+   if (mprotect(mapping->getData(), mapping->getSize(), PROT_READ | PROT_WRITE) != 0)
+      return nullptr;
+
+   //the audio thread is usually the first thing to read these buffers, so fault the pages in now on the loading thread,
+   //rather than taking disk reads inside the audio callback the first time the buffer plays
+   madvise(mapping->getData(), mapping->getSize(), MADV_WILLNEED);
+   const volatile char* bytes = static_cast<const char*>(mapping->getData());
+   size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+   for (size_t offset = 0; offset < mapping->getSize(); offset += pageSize)
+      (void)bytes[offset];
+
+   data = reinterpret_cast<float*>(static_cast<char*>(mapping->getData()) + (start - mapping->getRange().getStart()));
+   mStream->setPosition(start + numBytes);
+   return mapping;
+#endif
+}
+
 void FileStreamIn::ReadGeneric(void* buffer, int size)
 {
    mStream->read(buffer, size);
 }
 
+void FileStreamIn::SkipAlignmentPadding()
+{
+   char padding;
+   *this >> padding;
+   mStream->skipNextBytes(padding);
+}
+
+bool FileStreamIn::ReadChunkedFileHeader()
+{
+   char magic[sizeof(kChunkedFileMagic)]{};
+   Peek(magic, sizeof(magic));
+   if (memcmp(magic, kChunkedFileMagic, sizeof(magic)) != 0)
+      return false;
+
+   ReadGeneric(magic, sizeof(magic));
+   int rev;
+   *this >> rev;
+   juce::int64 headerEnd = mStream->getPosition();
+
+   //the table of contents is optional for loading, without it (say, a truncated file) we just read the stream without checking it
+   mChunks.clear();
+   juce::int64 totalLength = mStream->getTotalLength();
+   juce::int64 footerLength = sizeof(juce::int64) + sizeof(kChunkedFileFooterMagic);
+   if (rev <= kChunkedFileRev && totalLength >= headerEnd + footerLength)
+   {
+      mStream->setPosition(totalLength - footerLength);
+      juce::int64 tocOffset;
+      ReadGeneric(&tocOffset, sizeof(tocOffset));
+      char footerMagic[sizeof(kChunkedFileFooterMagic)];
+      ReadGeneric(footerMagic, sizeof(footerMagic));
+      if (memcmp(footerMagic, kChunkedFileFooterMagic, sizeof(footerMagic)) == 0 && tocOffset >= headerEnd && tocOffset < totalLength)
+      {
+         mStream->setPosition(tocOffset);
+         int numChunks;
+         *this >> numChunks;
+         for (int i = 0; i < numChunks && !Eof(); ++i)
+         {
+            FileStreamChunk chunk;
+            *this >> chunk.mName;
+            ReadGeneric(&chunk.mOffset, sizeof(chunk.mOffset));
+            ReadGeneric(&chunk.mLength, sizeof(chunk.mLength));
+            *this >> chunk.mChecksum;
+            mChunks.push_back(chunk);
+         }
+      }
+   }
+
+   if (mChunks.empty())
+      ofLog() << "chunked save file has no readable table of contents, loading it without checksums";
+
+   mStream->setPosition(headerEnd);
+   return true;
+}
+
+const FileStreamChunk* FileStreamIn::GetChunkAtPosition() const
+{
+   juce::int64 pos = mStream->getPosition();
+   for (const auto& chunk : mChunks)
+   {
+      if (chunk.mOffset == pos)
+         return &chunk;
+   }
+   return nullptr;
+}
+
+bool FileStreamIn::VerifyChunk(const FileStreamChunk& chunk)
+{
+   juce::int64 pos = mStream->getPosition();
+   mStream->setPosition(chunk.mOffset);
+
+   uint32_t crc = 0;
+   std::vector<char> block(kReadBufferSize);
+   juce::int64 remaining = chunk.mLength;
+   while (remaining > 0)
+   {
+      int toRead = (int)MIN(remaining, (juce::int64)block.size());
+      int numRead = mStream->read(block.data(), toRead);
+      if (numRead <= 0)
+         break;
+      crc = UpdateCrc32(crc, block.data(), numRead);
+      remaining -= numRead;
+   }
+
+   mStream->setPosition(pos);
+   return remaining == 0 && crc == chunk.mChecksum;
+}
+
+void FileStreamIn::SkipChunk(const FileStreamChunk& chunk)
+{
+   mStream->setPosition(chunk.mOffset + chunk.mLength);
+}
+
 void FileStreamIn::Peek(void* buffer, int size)
 {
    auto pos = mStream->getPosition();
@@ -196,5 +442,5 @@ int FileStreamIn::GetFilePosition() const
 
 bool FileStreamIn::OpenedOk() const
 {
-   return mStream->openedOk();
+   return mOpenedOk;
 }
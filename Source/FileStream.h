@@ -29,14 +29,24 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 #include "juce_core/juce_core.h"
 
 namespace juce
 {
-   class FileInputStream;
+   class InputStream;
    class FileOutputStream;
 }
 
+//a named range of a chunked save file, listed in the table of contents at the end of the file
+struct FileStreamChunk
+{
+   std::string mName;
+   juce::int64 mOffset{ 0 };
+   juce::int64 mLength{ 0 };
+   std::uint32_t mChecksum{ 0 }; //crc-32 of the chunk's bytes
+};
+
 class FileStreamOut
 {
 public:
@@ -52,10 +62,23 @@ public:
    FileStreamOut& operator<<(const char& var);
    void Write(const float* buffer, int size);
    void WriteGeneric(const void* buffer, int size);
+   void WriteAlignmentPadding(int alignment);
    juce::int64 GetSize() const;
+   static const int kWriteBufferSize = 1 << 20;
+
+   void BeginChunkedFile(); //writes the chunked file header, after this BeginChunk()/EndChunk() are recorded in a table of contents
+   bool BeginChunk(const std::string& name); //returns false without recording anything if this isn't a chunked file, or a chunk is already open
+   void EndChunk();
+   void EndChunkedFile(); //writes the table of contents and footer
 
 private:
+   void WriteBytes(const void* buffer, size_t size);
+
+   std::unique_ptr<juce::TemporaryFile> mTempFile;
    std::unique_ptr<juce::FileOutputStream> mStream;
+   bool mChunkedFile{ false };
+   bool mInChunk{ false };
+   std::vector<FileStreamChunk> mChunks;
 };
 
 class FileStreamIn
@@ -72,16 +95,26 @@ public:
    FileStreamIn& operator>>(std::string& var);
    FileStreamIn& operator>>(char& var);
    void Read(float* buffer, int size);
+   std::unique_ptr<juce::MemoryMappedFile> MapFloats(int size, float*& data);
    void ReadGeneric(void* buffer, int size);
+   void SkipAlignmentPadding();
+   bool ReadChunkedFileHeader(); //if this is a chunked file, reads its header and table of contents and returns true. otherwise leaves the position alone.
+   const FileStreamChunk* GetChunkAtPosition() const; //the chunk that starts at the current position, if there is one
+   bool VerifyChunk(const FileStreamChunk& chunk);
+   void SkipChunk(const FileStreamChunk& chunk);
    void Peek(void* buffer, int size);
    int GetFilePosition() const;
    bool OpenedOk() const;
    bool Eof() const;
    static bool s32BitMode;
    static const int sMaxStringLength = 999999; //the primary thing that might hit this limit is the json layout file (one user has had a file that exceeded a length of 100000)
+   static const int kReadBufferSize = 1 << 20;
 
 private:
-   std::unique_ptr<juce::FileInputStream> mStream;
+   juce::File mFile;
+   std::unique_ptr<juce::InputStream> mStream;
+   bool mOpenedOk{ false };
+   std::vector<FileStreamChunk> mChunks;
 };
 
 #endif /* defined(__Bespoke__FileStream__) */
@@ -26,6 +26,7 @@
 #include "IAudioSource.h"
 #include "IAudioReceiver.h"
 #include "PatchCableSource.h"
+#include "BlockEventQueue.h"
 
 IAudioReceiver* IAudioSource::GetTarget(int index)
 {
@@ -33,6 +34,28 @@ IAudioReceiver* IAudioSource::GetTarget(int index)
    return GetPatchCableSource(index)->GetAudioReceiver();
 }
 
+void IAudioSource::ProcessBlock(double time)
+{
+   BlockEventQueue* events = GetBlockEventQueue();
+   if (events == nullptr)
+   {
+      Process(time);
+      return;
+   }
+
+   int offset = 0;
+   while (offset < gBufferSize)
+   {
+      BlockEvent event;
+      while (events->PopDue(time, offset, event))
+         ApplyBlockEvent(event);
+
+      int end = MIN(events->GetNextOffset(time), gBufferSize);
+      ProcessSpan(time + offset * gInvSampleRateMs, offset, end - offset);
+      offset = end;
+   }
+}
+
 void IAudioSource::SyncOutputBuffer(int numChannels)
 {
    for (int i = 0; i < GetNumTargets(); ++i)
@@ -31,6 +31,8 @@
 #include "IPatchable.h"
 
 class IAudioReceiver;
+class BlockEventQueue;
+struct BlockEvent;
 
 #define VIZ_BUFFER_SECONDS .1f
 
@@ -39,13 +41,21 @@ class IAudioSource : public virtual IPatchable
 public:
    IAudioSource()
    : mVizBuffer(VIZ_BUFFER_SECONDS * gSampleRate)
-   {}
+   {
+      mVizBuffer.SetDemandDriven(true);
+   }
    virtual ~IAudioSource() {}
    virtual void Process(double time) = 0;
+   void ProcessBlock(double time);
    IAudioReceiver* GetTarget(int index = 0);
    virtual int GetNumTargets() { return 1; }
    RollingBuffer* GetVizBuffer() { return &mVizBuffer; }
 
+   //opt-in sample-accurate events: sources that return a queue here get their block rendered by ProcessSpan() in pieces, with ApplyBlockEvent() called at each queued event's sample
+   virtual BlockEventQueue* GetBlockEventQueue() { return nullptr; }
+   virtual void ProcessSpan(double time, int offset, int length) {}
+   virtual void ApplyBlockEvent(const BlockEvent& event) {}
+
 protected:
    void SyncOutputBuffer(int numChannels);
 
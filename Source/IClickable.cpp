@@ -31,6 +31,7 @@
 #include <cstring>
 
 std::string IClickable::sPathLoadContext = "";
+std::atomic<int> IClickable::sPathGeneration{ 0 };
 std::string IClickable::sPathSaveContext = "";
 
 IClickable::IClickable()
@@ -28,6 +28,8 @@
 
 #include "SynthGlobals.h"
 
+#include <atomic>
+
 //TODO(Ryan) factor Transformable stuff out of here
 
 class IDrawableModule;
@@ -67,7 +69,10 @@ public:
    void SetName(const char* name)
    {
       if (mName != name)
+      {
          StringCopy(mName, name, MAX_TEXTENTRY_LENGTH);
+         InvalidatePaths();
+      }
    }
    const char* Name() const { return mName; }
    char* NameMutable() { return mName; }
@@ -95,8 +100,13 @@ public:
    static void SetSaveContext(IClickable* context) { sPathSaveContext = context->Path() + "~"; }
    static void ClearSaveContext() { sPathSaveContext = ""; }
 
+   //bumped whenever something that paths resolve through is added, removed or renamed, so cached path lookups know to resolve again
+   static void InvalidatePaths() { ++sPathGeneration; }
+   static int GetPathGeneration() { return sPathGeneration; }
+
    static std::string sPathLoadContext;
    static std::string sPathSaveContext;
+   static std::atomic<int> sPathGeneration;
 
 protected:
    virtual void OnClicked(float x, float y, bool right) {}
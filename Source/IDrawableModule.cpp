@@ -194,9 +194,10 @@ void IDrawableModule::DrawFrame(float w, float h, bool drawModule, float& titleB
    if (IsEnabled())
    {
       IAudioSource* audioSource = dynamic_cast<IAudioSource*>(this);
-      if (audioSource)
+      if (audioSource && UserPrefs.draw_module_highlights.Get() && IsVisible())
       {
          RollingBuffer* vizBuff = audioSource->GetVizBuffer();
+         vizBuff->RequestCapture(RollingBuffer::CaptureDemand::kCoarse);
          int numSamples = std::min(500, vizBuff->Size());
          float sample;
          float mag = 0;
@@ -214,8 +215,7 @@ void IDrawableModule::DrawFrame(float w, float h, bool drawModule, float& titleB
          mag *= 3;
          mag = ofClamp(mag, 0, 1);
 
-         if (UserPrefs.draw_module_highlights.Get())
-            highlight = mag * .15f;
+         highlight = mag * .15f;
       }
 
       if (GetPatchCableSource() != nullptr)
@@ -737,6 +737,7 @@ IDrawableModule* IDrawableModule::FindChild(const char* name, bool fail) const
 
 void IDrawableModule::AddChild(IDrawableModule* child)
 {
+   InvalidatePaths();
    if (dynamic_cast<IDrawableModule*>(child->GetParent()))
       dynamic_cast<IDrawableModule*>(child->GetParent())->RemoveChild(child);
    child->SetParent(this);
@@ -757,6 +758,7 @@ void IDrawableModule::AddChild(IDrawableModule* child)
 
 void IDrawableModule::RemoveChild(IDrawableModule* child)
 {
+   InvalidatePaths();
    child->SetParent(nullptr);
    RemoveFromVector(child, mChildren);
 }
@@ -866,6 +868,7 @@ void IDrawableModule::AddUIControl(IUIControl* control)
    }
 
    mUIControls.push_back(control);
+   InvalidatePaths();
    FloatSlider* slider = dynamic_cast<FloatSlider*>(control);
    if (slider)
    {
@@ -881,6 +884,7 @@ void IDrawableModule::RemoveUIControl(IUIControl* control, bool cleanUpReference
       IUIControl::DestroyCablesTargetingControls(std::vector<IUIControl*>{ control });
 
    RemoveFromVector(control, mUIControls, K(fail));
+   InvalidatePaths();
    FloatSlider* slider = dynamic_cast<FloatSlider*>(control);
    if (slider)
    {
@@ -893,6 +897,7 @@ void IDrawableModule::RemoveUIControl(IUIControl* control, bool cleanUpReference
 void IDrawableModule::AddUIGrid(UIGrid* grid)
 {
    mUIGrids.push_back(grid);
+   InvalidatePaths();
 }
 
 void IDrawableModule::ComputeSliders(int samplesIn)
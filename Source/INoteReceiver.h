@@ -34,11 +34,26 @@ namespace juce
    class MidiMessage;
 }
 
+struct NoteEvent
+{
+   double time{ 0 };
+   int pitch{ 0 };
+   int velocity{ 0 };
+   int voiceIdx{ -1 };
+   ModulationParameters modulation;
+};
+
 class INoteReceiver
 {
 public:
    virtual ~INoteReceiver() {}
    virtual void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) = 0;
+   //receives several notes at once, in order. receivers that don't override this get them one at a time through PlayNote()
+   virtual void PlayNotes(const NoteEvent* notes, int count)
+   {
+      for (int i = 0; i < count; ++i)
+         PlayNote(notes[i].time, notes[i].pitch, notes[i].velocity, notes[i].voiceIdx, notes[i].modulation);
+   }
    virtual void SendPressure(int pitch, int pressure) {}
    virtual void SendCC(int control, int value, int voiceIdx = -1) = 0;
    virtual void SendMidi(const juce::MidiMessage& message) {}
@@ -65,18 +65,69 @@ void NoteOutput::PlayNoteInternal(double time, int pitch, int velocity, int voic
       for (auto noteReceiver : mNoteSource->GetPatchCableSource()->GetNoteReceivers())
          noteReceiver->PlayNote(time, pitch, velocity, voiceIdx, modulation);
 
-      if (velocity > 0)
-      {
-         mNoteOnTimes[pitch] = time;
-         mNotes[pitch] = true;
-      }
-      else
+      UpdateHeldNote(time, pitch, velocity);
+
+      mNoteSource->GetPatchCableSource()->AddHistoryEvent(time, HasHeldNotes());
+   }
+}
+
+void NoteOutput::PlayNotes(const NoteEvent* notes, int count)
+{
+   ResetStackDepth();
+   PlayNotesInternal(notes, count);
+}
+
+void NoteOutput::PlayNotesInternal(const NoteEvent* notes, int count)
+{
+   if (count == 0)
+      return;
+
+   bool allInRange = true;
+   for (int i = 0; i < count; ++i)
+   {
+      if (notes[i].pitch < 0 || notes[i].pitch > 127)
       {
-         if (time > mNoteOnTimes[pitch])
-            mNotes[pitch] = false;
+         allInRange = false;
+         break;
       }
+   }
 
-      mNoteSource->GetPatchCableSource()->AddHistoryEvent(time, HasHeldNotes());
+   if (!IsAudioThread() || !allInRange)
+   {
+      //fall back to the per-note path, which queues notes from other threads and drops out-of-range pitches
+      for (int i = 0; i < count; ++i)
+         PlayNoteInternal(notes[i].time, notes[i].pitch, notes[i].velocity, notes[i].voiceIdx, notes[i].modulation, false);
+      return;
+   }
+
+   const int kMaxDepth = 100;
+   if (mStackDepth > kMaxDepth)
+   {
+      TheSynth->LogEvent("note chain hit max stack depth", kLogEventType_Error);
+      return; //avoid stack overflow
+   }
+   ++mStackDepth;
+
+   for (auto noteReceiver : mNoteSource->GetPatchCableSource()->GetNoteReceivers())
+      noteReceiver->PlayNotes(notes, count);
+
+   for (int i = 0; i < count; ++i)
+      UpdateHeldNote(notes[i].time, notes[i].pitch, notes[i].velocity);
+
+   mNoteSource->GetPatchCableSource()->AddHistoryEvent(notes[count - 1].time, HasHeldNotes());
+}
+
+void NoteOutput::UpdateHeldNote(double time, int pitch, int velocity)
+{
+   if (velocity > 0)
+   {
+      mNoteOnTimes[pitch] = time;
+      mNotes[pitch] = true;
+   }
+   else
+   {
+      if (time > mNoteOnTimes[pitch])
+         mNotes[pitch] = false;
    }
 }
 
@@ -128,21 +179,36 @@ void NoteOutput::Flush(double time)
    }
 
    bool flushed = false;
+   NoteBatch batch;
 
    for (int i = 0; i < 128; ++i)
    {
       if (mNotes[i])
       {
-         for (auto noteReceiver : mNoteSource->GetPatchCableSource()->GetNoteReceivers())
+         if (batch.GetCount() + 2 > NoteBatch::kMaxSize)
          {
-            noteReceiver->PlayNote(time, i, 0);
-            noteReceiver->PlayNote(time + Transport::sEventEarlyMs, i, 0);
+            for (auto noteReceiver : mNoteSource->GetPatchCableSource()->GetNoteReceivers())
+               noteReceiver->PlayNotes(batch.GetNotes(), batch.GetCount());
+            batch.Clear();
          }
+
+         NoteEvent noteOff;
+         noteOff.time = time;
+         noteOff.pitch = i;
+         batch.Add(noteOff);
+         noteOff.time = time + Transport::sEventEarlyMs;
+         batch.Add(noteOff);
          flushed = true;
          mNotes[i] = false;
       }
    }
 
+   if (batch.GetCount() > 0)
+   {
+      for (auto noteReceiver : mNoteSource->GetPatchCableSource()->GetNoteReceivers())
+         noteReceiver->PlayNotes(batch.GetNotes(), batch.GetCount());
+   }
+
    if (flushed)
       mNoteSource->GetPatchCableSource()->AddHistoryEvent(time, false);
 }
@@ -161,6 +227,30 @@ void INoteSource::PlayNoteOutput(double time, int pitch, int velocity, int voice
    mInNoteOutput = false;
 }
 
+void INoteSource::PlayNotesOutput(const NoteEvent* notes, int count)
+{
+   PROFILER(INoteSourcePlayNotesOutput);
+
+   if (!mInNoteOutput)
+      mNoteOutput.ResetStackDepth();
+   mInNoteOutput = true;
+   mNoteOutput.PlayNotesInternal(notes, count);
+   mInNoteOutput = false;
+}
+
+void INoteSource::PlayNotesOutput(NoteBatch& batch)
+{
+   PlayNotesOutput(batch.GetNotes(), batch.GetCount());
+   batch.Clear();
+}
+
+void INoteSource::AddToNoteBatch(NoteBatch& batch, const NoteEvent& note)
+{
+   if (batch.IsFull())
+      PlayNotesOutput(batch);
+   batch.Add(note);
+}
+
 void INoteSource::SendCCOutput(int control, int value, int voiceIdx /*=-1*/)
 {
    mNoteOutput.SendCC(control, value, voiceIdx);
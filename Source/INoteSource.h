@@ -30,6 +30,8 @@
 #include "INoteReceiver.h"
 #include "IPatchable.h"
 
+#include <array>
+
 class IDrawableModule;
 
 class INoteSource;
@@ -46,11 +48,13 @@ public:
 
    //INoteReceiver
    void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) override;
+   void PlayNotes(const NoteEvent* notes, int count) override;
    void SendPressure(int pitch, int pressure) override;
    void SendCC(int control, int value, int voiceIdx = -1) override;
    void SendMidi(const juce::MidiMessage& message) override;
 
    void PlayNoteInternal(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation, bool isFromMainThreadAndScheduled);
+   void PlayNotesInternal(const NoteEvent* notes, int count);
 
    void ResetStackDepth() { mStackDepth = 0; }
    bool* GetNotes() { return mNotes; }
@@ -58,12 +62,31 @@ public:
    std::list<int> GetHeldNotesList();
 
 private:
+   void UpdateHeldNote(double time, int pitch, int velocity);
+
    bool mNotes[128]{};
    double mNoteOnTimes[128]{};
    INoteSource* mNoteSource{ nullptr };
    int mStackDepth{ 0 };
 };
 
+//gathers notes so they can be sent to receivers together with INoteSource::PlayNotesOutput()
+class NoteBatch
+{
+public:
+   static const int kMaxSize = 64;
+
+   void Add(const NoteEvent& note) { mNotes[mCount++] = note; }
+   bool IsFull() const { return mCount == kMaxSize; }
+   const NoteEvent* GetNotes() const { return mNotes.data(); }
+   int GetCount() const { return mCount; }
+   void Clear() { mCount = 0; }
+
+private:
+   std::array<NoteEvent, kMaxSize> mNotes;
+   int mCount{ 0 };
+};
+
 class INoteSource : public virtual IPatchable
 {
 public:
@@ -72,6 +95,9 @@ public:
    {}
    virtual ~INoteSource() {}
    void PlayNoteOutput(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters(), bool isFromMainThreadAndScheduled = false);
+   void PlayNotesOutput(const NoteEvent* notes, int count);
+   void PlayNotesOutput(NoteBatch& batch);
+   void AddToNoteBatch(NoteBatch& batch, const NoteEvent& note);
    void SendCCOutput(int control, int value, int voiceIdx = -1);
 
    //IPatchable
@@ -27,9 +27,17 @@
 
 #include "IPulseReceiver.h"
 #include "PatchCableSource.h"
+#include "ModularSynth.h"
+#include "NoteOutputQueue.h"
 
 void IPulseSource::DispatchPulse(PatchCableSource* destination, double time, float velocity, int flags)
 {
+   if (!IsAudioThread())
+   {
+      TheSynth->GetNoteOutputQueue()->QueuePulse(this, destination, time, velocity, flags);
+      return;
+   }
+
    if (time == destination->GetLastOnEventTime()) //avoid stack overflow
       return;
 
@@ -120,10 +120,8 @@ void KarplusStrong::Process(double time)
    mBiquad.ProcessAudio(time, &mWriteBuffer);
 
    for (int ch = 0; ch < mWriteBuffer.NumActiveChannels(); ++ch)
-   {
       GetVizBuffer()->WriteChunk(mWriteBuffer.GetChannel(ch), mWriteBuffer.BufferSize(), ch);
-      Add(target->GetBuffer()->GetChannel(ch), mWriteBuffer.GetChannel(ch), gBufferSize);
-   }
+   mWriteBuffer.MixInto(target->GetBuffer(), mWriteBuffer.NumActiveChannels());
 
    GetBuffer()->Reset();
 }
@@ -32,6 +32,7 @@
 #include "ChannelBuffer.h"
 #include "PolyphonyMgr.h"
 #include "SingleOscillatorVoice.h"
+#include "CpuGovernor.h"
 
 #include "juce_core/juce_core.h"
 
@@ -89,12 +90,13 @@ bool KarplusStrongVoice::Process(double time, ChannelBuffer* out, int oversampli
    float pitch;
    float oscPhaseInc;
 
-   if (mVoiceParams->mLiteCPUMode)
+   bool liteCPUMode = mVoiceParams->mLiteCPUMode || CpuGovernor::UseBlockRateParameters();
+   if (liteCPUMode)
       DoParameterUpdate(0, oversampling, pitch, freq, filterRate, filterLerp, oscPhaseInc);
 
    for (int pos = 0; pos < bufferSize; ++pos)
    {
-      if (!mVoiceParams->mLiteCPUMode)
+      if (!liteCPUMode)
          DoParameterUpdate(pos / oversampling, oversampling, pitch, freq, filterRate, filterLerp, oscPhaseInc);
 
       if (mVoiceParams->mSourceType == kSourceTypeSaw)
@@ -50,9 +50,9 @@ float LFO::CalculatePhase(int samplesIn /*= 0*/, bool doTransform /* = true*/) c
    }
    else
    {
-      float period = TheTransport->GetDuration(mPeriod) / TheTransport->GetDuration(kInterval_1n);
+      float period = TheTransport->GetMeasureFraction(mPeriod);
 
-      float phase = TheTransport->GetMeasureTime(gTime + samplesIn * gInvSampleRateMs) / period + (1 - mPhaseOffset) + 1; //+1 so we can have negative samplesIn
+      float phase = TheTransport->GetMeasureTimeForSample(samplesIn) / period + (1 - mPhaseOffset) + 1; //+1 so we can have negative samplesIn
 
       phase -= int(phase) / 2 * 2; //using 2 allows for shuffle to work
 
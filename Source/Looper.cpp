@@ -54,6 +54,8 @@ Looper::Looper()
    //TODO(Ryan) buffer sizes
    mBuffer = new ChannelBuffer(MAX_BUFFER_SIZE);
    mUndoBuffer = new ChannelBuffer(MAX_BUFFER_SIZE);
+   mBuffer->EnablePeakPyramid();
+   mUndoBuffer->EnablePeakPyramid();
    Clear();
 
    mMuteRamp.SetValue(1);
@@ -275,6 +277,7 @@ void Looper::Process(double time)
       for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
          mJumpBlender[ch].CaptureForJump(mLoopPos, mBuffer->GetChannel(ch), mLoopLength, 0);
       mBuffer = mQueuedNewBuffer;
+      mBufferUsedLength = mBuffer->BufferSize(); //we don't know where this one has been
       mBufferMutex.unlock();
       mQueuedNewBuffer = nullptr;
    }
@@ -286,6 +289,8 @@ void Looper::Process(double time)
       latencyOffset = mPitchShifter[0]->GetLatency();
 
    double processStartTime = time;
+   int writeStart = INT_MAX;
+   int writeEnd = -1;
    for (int i = 0; i < bufferSize; ++i)
    {
       float smooth = .001f;
@@ -328,7 +333,12 @@ void Looper::Process(double time)
          //write one sample the past so we don't end up feeding into the next output
          float writeAmount = mWriteInputRamp.Value(time);
          if (writeAmount > 0)
+         {
             WriteInterpolatedSample(offset - 1, mBuffer->GetChannel(ch), mLoopLength, mLastInputSample[ch] * writeAmount);
+            int writePos = int(DoubleWrap(offset - 1, mLoopLength));
+            writeStart = MIN(writeStart, writePos);
+            writeEnd = MAX(writeEnd, writePos + 2);
+         }
          mLastInputSample[ch] = GetBuffer()->GetChannel(ch)[i];
 
          output[ch] = mSwitchAndRamp.Process(ch, output[ch] * volSq);
@@ -341,6 +351,9 @@ void Looper::Process(double time)
       time += gInvSampleRateMs;
    }
 
+   if (writeEnd > writeStart)
+      mBuffer->MarkWritten(writeStart, writeEnd - writeStart); //covers the whole loop if the writes wrapped around
+
    if (mPitchShift != 1)
    {
       for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
@@ -385,7 +398,7 @@ void Looper::DoCommit(double time)
 
    {
       PROFILER(Looper_DoCommit_undo);
-      mUndoBuffer->CopyFrom(mBuffer, mLoopLength);
+      CopyToUndoBuffer();
    }
 
    if (mReplaceOnCommit)
@@ -419,6 +432,7 @@ void Looper::DoCommit(double time)
             mBuffer->GetChannel(ch)[pos] += mCommitBuffer->GetSample(ofClamp(commitLength - i + commitSamplesBack, 0, MAX_BUFFER_SIZE - 1), ch) * fade;
          }
       }
+      mBuffer->InvalidatePeaks();
    }
 
    mClearCommitBuffer = true;
@@ -427,6 +441,13 @@ void Looper::DoCommit(double time)
 void Looper::Fill(ChannelBuffer* buffer, int length)
 {
    mBuffer->CopyFrom(buffer, length);
+   mBufferUsedLength = MAX(mBufferUsedLength, length);
+}
+
+void Looper::CopyToUndoBuffer()
+{
+   mUndoBuffer->CopyFrom(mBuffer, mLoopLength);
+   mUndoBufferUsedLength = MAX(mUndoBufferUsedLength, mLoopLength);
 }
 
 void Looper::DoUndo()
@@ -434,6 +455,7 @@ void Looper::DoUndo()
    ChannelBuffer* swap = mUndoBuffer;
    mUndoBuffer = mBuffer;
    mBuffer = swap;
+   std::swap(mBufferUsedLength, mUndoBufferUsedLength);
    mWantUndo = false;
 }
 
@@ -587,6 +609,7 @@ void Looper::ResampleForSpeed(float speed)
       }
       delete[] oldBuffer;
    }
+   mBuffer->InvalidatePeaks();
 
    if (mKeepPitch)
    {
@@ -846,7 +869,9 @@ bool Looper::DrawToPush2Screen()
 
 void Looper::Clear()
 {
-   mBuffer->Clear();
+   //recording, overdubs and commits all write within the loop without raising the used length, so never let it fall below the loop
+   mBuffer->Clear(MIN(MAX(mBufferUsedLength, mLoopLength), mBuffer->BufferSize()));
+   mBufferUsedLength = mLoopLength;
    mLastCommitTime = gTime;
    mVol = 1;
    mFourTet = 0;
@@ -864,9 +889,10 @@ void Looper::SetNumBars(int numBars)
 
 void Looper::BakeVolume()
 {
-   mUndoBuffer->CopyFrom(mBuffer, mLoopLength);
+   CopyToUndoBuffer();
    for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
       Mult(mBuffer->GetChannel(ch), mVol * mVol, mLoopLength);
+   mBuffer->MarkWritten(0, mLoopLength);
    mVol = 1;
    mSmoothedVol = 1;
    mWantBakeVolume = false;
@@ -889,6 +915,7 @@ void Looper::UpdateNumBars(int oldNumBars)
          for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
             BufferCopy(mBuffer->GetChannel(ch) + oldLoopLength * i, mBuffer->GetChannel(ch), oldLoopLength);
       }
+      mBuffer->InvalidatePeaks();
    }
 }
 
@@ -896,6 +923,7 @@ void Looper::SetLoopLength(int length)
 {
    assert(length > 0);
    mLoopLength = length;
+   mBufferUsedLength = MAX(mBufferUsedLength, length);
    if (mLoopPosOffsetSlider != nullptr)
       mLoopPosOffsetSlider->SetExtents(0, length);
    mBufferTempo = TheTransport->GetTempo();
@@ -916,6 +944,7 @@ void Looper::MergeIn(Looper* otherLooper)
          Mult(otherLooper->mBuffer->GetChannel(ch), (otherLooper->mVol * otherLooper->mVol) / (mVol * mVol), mLoopLength); //keep other looper at same apparent volume
          Add(mBuffer->GetChannel(ch), otherLooper->mBuffer->GetChannel(ch), mLoopLength);
       }
+      mBuffer->MarkWritten(0, mLoopLength);
    }
    else //ours was silent, just replace it
    {
@@ -938,6 +967,7 @@ void Looper::SwapBuffers(Looper* otherLooper)
    float vol = otherLooper->mVol;
    otherLooper->mVol = mVol;
    otherLooper->mBuffer = mBuffer;
+   std::swap(mBufferUsedLength, otherLooper->mBufferUsedLength);
    otherLooper->SetLoopLength(mLoopLength);
    otherLooper->mNumBars = mNumBars;
    mBuffer = temp;
@@ -1019,6 +1049,7 @@ void Looper::SampleDropped(int x, int y, Sample* sample)
       for (int ch = 0; ch < sample->NumChannels(); ++ch)
          mBuffer->GetChannel(ch)[i] = GetInterpolatedSample(offset, sample->Data()->GetChannel(ch), numSamples);
    }
+   mBuffer->MarkWritten(0, mLoopLength);
 }
 
 void Looper::GetModuleDimensions(float& width, float& height)
@@ -1048,7 +1079,7 @@ void Looper::ButtonClicked(ClickButton* button, double time)
 {
    if (button == mClearButton)
    {
-      mUndoBuffer->CopyFrom(mBuffer, mLoopLength);
+      CopyToUndoBuffer();
       Clear();
    }
    if (button == mMergeButton && mRecorder)
@@ -1184,45 +1215,21 @@ void Looper::HalveNumBars()
 void Looper::DoShiftMeasure()
 {
    int measureSize = int(TheTransport->MsPerBar() * gSampleRate / 1000);
-   for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
-   {
-      float* newBuffer = new float[MAX_BUFFER_SIZE];
-      BufferCopy(newBuffer, mBuffer->GetChannel(ch) + measureSize, mLoopLength - measureSize);
-      BufferCopy(newBuffer + mLoopLength - measureSize, mBuffer->GetChannel(ch), measureSize);
-      mBufferMutex.lock();
-      mBuffer->SetChannelPointer(newBuffer, ch, true);
-      mBufferMutex.unlock();
-   }
+   RotateBuffer(measureSize);
    mWantShiftMeasure = false;
 }
 
 void Looper::DoHalfShift()
 {
    int halfMeasureSize = int(TheTransport->MsPerBar() * gSampleRate / 1000 / 2);
-   for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
-   {
-      float* newBuffer = new float[MAX_BUFFER_SIZE];
-      BufferCopy(newBuffer, mBuffer->GetChannel(ch) + halfMeasureSize, mLoopLength - halfMeasureSize);
-      BufferCopy(newBuffer + mLoopLength - halfMeasureSize, mBuffer->GetChannel(ch), halfMeasureSize);
-      mBufferMutex.lock();
-      mBuffer->SetChannelPointer(newBuffer, ch, true);
-      mBufferMutex.unlock();
-   }
+   RotateBuffer(halfMeasureSize);
    mWantHalfShift = false;
 }
 
 void Looper::DoShiftDownbeat()
 {
    int shift = int(mLoopPos);
-   for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
-   {
-      float* newBuffer = new float[MAX_BUFFER_SIZE];
-      BufferCopy(newBuffer, mBuffer->GetChannel(ch) + shift, mLoopLength - shift);
-      BufferCopy(newBuffer + mLoopLength - shift, mBuffer->GetChannel(ch), shift);
-      mBufferMutex.lock();
-      mBuffer->SetChannelPointer(newBuffer, ch, true);
-      mBufferMutex.unlock();
-   }
+   RotateBuffer(shift);
    mWantShiftDownbeat = false;
 }
 
@@ -1230,21 +1237,28 @@ void Looper::DoShiftOffset()
 {
    int shift = int(mLoopPosOffset);
    if (shift != 0)
-   {
-      for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
-      {
-         float* newBuffer = new float[MAX_BUFFER_SIZE];
-         BufferCopy(newBuffer, mBuffer->GetChannel(ch) + shift, mLoopLength - shift);
-         BufferCopy(newBuffer + mLoopLength - shift, mBuffer->GetChannel(ch), shift);
-         mBufferMutex.lock();
-         mBuffer->SetChannelPointer(newBuffer, ch, true);
-         mBufferMutex.unlock();
-      }
-   }
+      RotateBuffer(shift);
    mWantShiftOffset = false;
    mLoopPosOffset = 0;
 }
 
+void Looper::RotateBuffer(int shift)
+{
+   //rotate in place rather than allocating a fresh buffer on the audio thread
+   shift = ((shift % mLoopLength) + mLoopLength) % mLoopLength;
+   if (shift == 0)
+      return;
+
+   mBufferMutex.lock();
+   for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
+   {
+      float* channel = mBuffer->GetChannel(ch);
+      std::rotate(channel, channel + shift, channel + mLoopLength);
+   }
+   mBuffer->MarkWritten(0, mLoopLength);
+   mBufferMutex.unlock();
+}
+
 void Looper::Rewrite()
 {
    mWantRewrite = true;
@@ -1304,4 +1318,5 @@ void Looper::LoadState(FileStreamIn& in, int rev)
    int readLength;
    mBuffer->Load(in, readLength, ChannelBuffer::LoadMode::kAnyBufferSize);
    assert(mLoopLength == readLength);
+   mBufferUsedLength = MAX(mBufferUsedLength, readLength);
 }
@@ -135,10 +135,12 @@ private:
    void DoHalfShift();
    void DoShiftDownbeat();
    void DoShiftOffset();
+   void RotateBuffer(int shift);
    void DoCommit(double time);
    void UpdateNumBars(int oldNumBars);
    void BakeVolume();
    void DoUndo();
+   void CopyToUndoBuffer();
    void ProcessFourTet(double time, int sampleIdx);
    void ProcessScratch();
    void ProcessBeatwheel(double time, int sampleIdx);
@@ -186,6 +188,8 @@ private:
    ClickButton* mHalveSpeedButton{ nullptr };
    ClickButton* mExtendButton{ nullptr };
    ChannelBuffer* mUndoBuffer{ nullptr };
+   int mBufferUsedLength{ 0 }; //everything in mBuffer past this point is silent, so Clear() can skip it and leave those pages uncommitted
+   int mUndoBufferUsedLength{ 0 };
    ClickButton* mUndoButton{ nullptr };
    bool mWantUndo{ false };
    bool mReplaceOnCommit{ false };
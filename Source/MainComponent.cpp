@@ -216,7 +216,10 @@ public:
       if (UserPrefs.devicetype.Get() != kAutoDevice)
          mGlobalManagers.mDeviceManager.setCurrentAudioDeviceType(UserPrefs.devicetype.Get(), true);
 
-      SetGlobalSampleRateAndBufferSize(UserPrefs.samplerate.Get(), UserPrefs.buffersize.Get());
+      int engineBlockSize = UserPrefs.engine_block_size.Get();
+      if (engineBlockSize <= 0)
+         engineBlockSize = UserPrefs.buffersize.Get();
+      SetGlobalSampleRateAndBufferSize(UserPrefs.samplerate.Get(), engineBlockSize);
 
       mSynth.Setup(&mGlobalManagers.mDeviceManager, &mGlobalManagers.mAudioFormatManager, this, &openGLContext);
 
@@ -227,7 +230,7 @@ public:
 
       AudioDeviceManager::AudioDeviceSetup preferredSetupOptions;
       preferredSetupOptions.sampleRate = gSampleRate / UserPrefs.oversampling.Get();
-      preferredSetupOptions.bufferSize = gBufferSize / UserPrefs.oversampling.Get();
+      preferredSetupOptions.bufferSize = UserPrefs.buffersize.Get();
       if (outputDevice != kAutoDevice && outputDevice != kNoneDevice)
          preferredSetupOptions.outputDeviceName = outputDevice;
       if (inputDevice != kAutoDevice && inputDevice != kNoneDevice)
@@ -268,9 +271,9 @@ public:
             mSynth.SetFatalError("error setting input device to '" + inputDevice + "', fix this in userprefs.json (use \"auto\" for default device, or \"none\" for no device)" +
                                  "\n\n\nvalid devices:\n" + GetAudioDevices());
          }
-         else if (loadedSetup.bufferSize != gBufferSize / UserPrefs.oversampling.Get())
+         else if (loadedSetup.bufferSize != UserPrefs.buffersize.Get() && loadedSetup.bufferSize > ModularSynth::kMaxFifoDeviceBufferSize)
          {
-            mSynth.SetFatalError("error setting buffer size to " + ofToString(gBufferSize / UserPrefs.oversampling.Get()) + " on device '" + loadedSetup.outputDeviceName.toStdString() + "', fix this in userprefs.json" +
+            mSynth.SetFatalError("error setting buffer size to " + ofToString(UserPrefs.buffersize.Get()) + " on device '" + loadedSetup.outputDeviceName.toStdString() + "', fix this in userprefs.json" +
                                  "\n\n(a valid buffer size might be: " + ofToString(loadedSetup.bufferSize) + ")");
          }
          else if (loadedSetup.sampleRate != gSampleRate / UserPrefs.oversampling.Get())
@@ -280,6 +283,9 @@ public:
          }
          else
          {
+            if (loadedSetup.bufferSize != UserPrefs.buffersize.Get())
+               ofLog() << "couldn't set buffer size to " << UserPrefs.buffersize.Get() << " on device '" << loadedSetup.outputDeviceName << "', it is using " << loadedSetup.bufferSize << " instead. the engine will buffer between the two, which adds latency";
+
             ofLog() << "output: " << loadedSetup.outputDeviceName << "   input: " << loadedSetup.inputDeviceName;
 
             int numInputChannels = 0;
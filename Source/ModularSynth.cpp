@@ -14,6 +14,10 @@
 #include "ChaosEngine.h"
 #include "ModuleSaveDataPanel.h"
 #include "Profiler.h"
+#include "RealtimeSafetyMonitor.h"
+#include "RealtimePool.h"
+#include "CpuGovernor.h"
+#include "SampleAnalyzer.h"
 #include "Sample.h"
 #include "FloatSliderLFOControl.h"
 //#include <CoreServices/CoreServices.h>
@@ -89,6 +93,7 @@ ModularSynth::ModularSynth()
 
    mAudioPluginFormatManager = std::make_unique<juce::AudioPluginFormatManager>();
    mKnownPluginList = std::make_unique<juce::KnownPluginList>();
+   mKnownPluginList->addChangeListener(&mModuleFactory);
 
    mAudioPluginFormatManager->addDefaultFormats();
 }
@@ -96,9 +101,13 @@ ModularSynth::ModularSynth()
 ModularSynth::~ModularSynth()
 {
    DeleteAllModules();
+   SampleAnalyzer::Shutdown();
 
+   if (mSaveOutputThread.joinable())
+      mSaveOutputThread.join();
    delete mGlobalRecordBuffer;
    mAudioPluginFormatManager.reset();
+   mKnownPluginList->removeChangeListener(&mModuleFactory);
    mKnownPluginList.reset();
 
    SetMemoryTrackingEnabled(false); //avoid crashes when the tracking lists themselves are deleted
@@ -233,7 +242,9 @@ void ModularSynth::Setup(juce::AudioDeviceManager* globalAudioDeviceManager, juc
 
    sShouldAutosave = UserPrefs.autosave.Get();
 
-   mIOBufferSize = gBufferSize;
+   mDeviceBufferSize = UserPrefs.buffersize.Get();
+
+   RealtimePool::Init();
 
    mGlobalRecordBuffer = new RollingBuffer(UserPrefs.record_buffer_length_minutes.Get() * 60 * gSampleRate);
    mGlobalRecordBuffer->SetNumChannels(2);
@@ -297,6 +308,10 @@ void ModularSynth::InitIOBuffers(int inputChannelCount, int outputChannelCount)
       mInputBuffers.push_back(new float[gBufferSize]);
    for (int i = 0; i < outputChannelCount; ++i)
       mOutputBuffers.push_back(new float[gBufferSize]);
+
+   int fifoSize = gBufferSize + kMaxFifoDeviceBufferSize * UserPrefs.oversampling.Get();
+   mInputFifo.assign(inputChannelCount, std::vector<float>(fifoSize));
+   mOutputFifo.assign(outputChannelCount, std::vector<float>(fifoSize));
 }
 
 
@@ -343,6 +358,10 @@ void ModularSynth::Poll()
 
    mZoomer.Update();
 
+   if (mNoteOutputQueue != nullptr)
+      mNoteOutputQueue->ReportDroppedEvents();
+   CpuGovernor::Poll();
+
    if (!mIsLoadingState)
    {
       for (auto p : mExtraPollers)
@@ -608,6 +627,7 @@ void ModularSynth::Draw(void* vg)
       float moduleX, moduleY;
       mLissajousDrawers[i]->GetPosition(moduleX, moduleY);
       IAudioSource* source = dynamic_cast<IAudioSource*>(mLissajousDrawers[i]);
+      source->GetVizBuffer()->RequestCapture(RollingBuffer::CaptureDemand::kFull);
       DrawLissajous(source->GetVizBuffer(), moduleX, moduleY - 240, 240, 240);
    }
 
@@ -686,6 +706,7 @@ void ModularSynth::Draw(void* vg)
       mUILayerModuleContainer.DrawContents();
 
       Profiler::Draw();
+      RealtimeSafetyMonitor::Draw();
       DrawConsole();
    }
    ofPopMatrix();
@@ -2000,73 +2021,143 @@ void ModularSynth::AudioOut(float* const* output, int bufferSize, int nChannels)
    ScopedMutex mutex(&mAudioThreadMutex, "audioOut()");
 
    /////////// AUDIO PROCESSING STARTS HERE /////////////
+   RealtimeSafetyMonitor::SetContext("note output queue");
    mNoteOutputQueue->Process();
 
    int oversampling = UserPrefs.oversampling.Get();
+   int ioBufferSize = bufferSize * oversampling;
 
-   assert(bufferSize * oversampling == mIOBufferSize);
    assert(nChannels == (int)mOutputBuffers.size());
-   assert(mIOBufferSize == gBufferSize); //need to be the same for now
-   //if we want these different, need to fix outBuffer here, and also fix audioIn()
-   //by now, many assumptions will have to be fixed to support mIOBufferSize and gBufferSize diverging
-   for (int ioOffset = 0; ioOffset < mIOBufferSize; ioOffset += gBufferSize)
-   {
-      for (size_t i = 0; i < mOutputBuffers.size(); ++i)
-         Clear(mOutputBuffers[i], mIOBufferSize);
+   if (ioBufferSize != gBufferSize)
+      EngageIOFifo();
 
-      double elapsed = gInvSampleRateMs * mIOBufferSize;
-      gTime += elapsed;
-      TheTransport->Advance(elapsed);
-
-      //process all audio
-      for (int i = 0; i < mSources.size(); ++i)
-         mSources[i]->Process(gTime);
+   if (mUseIOFifo && ioBufferSize > kMaxFifoDeviceBufferSize * oversampling)
+   {
+      static bool sWarned = false;
+      if (!sWarned)
+         ofLog() << "audio device buffer size " << bufferSize << " is larger than we can adapt to, set engine_block_size to match it";
+      sWarned = true;
+      for (int ch = 0; ch < nChannels; ++ch)
+         Clear(output[ch], bufferSize);
+      ioBufferSize = 0;
+   }
 
-      if (gTime - mLastClapboardTime < 100)
+   if (!mUseIOFifo)
+   {
+      RenderBlock();
+   }
+   else
+   {
+      //render as many whole blocks as it takes to cover this callback, and keep the remainder for the next one
+      while (mOutputFifoCount < ioBufferSize)
       {
-         for (int ch = 0; ch < nChannels; ++ch)
+         int available = MIN(mInputFifoCount, gBufferSize);
+         for (size_t ch = 0; ch < mInputBuffers.size(); ++ch)
          {
-            for (int i = 0; i < bufferSize; ++i)
-            {
-               float sample = sin(GetPhaseInc(440) * i) * (1 - ((gTime - mLastClapboardTime) / 100));
-               output[ch][i] = sample;
-            }
+            float* fifo = mInputFifo[ch].data();
+            BufferCopy(mInputBuffers[ch], fifo, available);
+            Clear(mInputBuffers[ch] + available, gBufferSize - available);
+            std::copy(fifo + available, fifo + mInputFifoCount, fifo);
          }
+         mInputFifoCount -= available;
+
+         RenderBlock();
+
+         for (size_t ch = 0; ch < mOutputBuffers.size(); ++ch)
+            BufferCopy(mOutputFifo[ch].data() + mOutputFifoCount, mOutputBuffers[ch], gBufferSize);
+         mOutputFifoCount += gBufferSize;
       }
+   }
 
-      //put it into speakers
-      for (int ch = 0; ch < nChannels; ++ch)
+   //put it into speakers
+   for (int ch = 0; ch < nChannels && ioBufferSize > 0; ++ch)
+   {
+      const float* src = mUseIOFifo ? mOutputFifo[ch].data() : mOutputBuffers[ch];
+      if (oversampling == 1)
       {
-         if (oversampling == 1)
-         {
-            BufferCopy(output[ch], mOutputBuffers[ch], gBufferSize);
-            if (ch < 2)
-               mGlobalRecordBuffer->WriteChunk(output[ch], bufferSize, ch);
-         }
-         else
+         BufferCopy(output[ch], src, bufferSize);
+      }
+      else
+      {
+         for (int sampleIndex = 0; sampleIndex < bufferSize; ++sampleIndex)
          {
-            for (int sampleIndex = 0; sampleIndex < gBufferSize / oversampling; ++sampleIndex)
-            {
-               output[ch][sampleIndex] = 0;
-               for (int subsampleIndex = 0; subsampleIndex < oversampling; ++subsampleIndex)
-               {
-                  float sample = mOutputBuffers[ch][sampleIndex * oversampling + subsampleIndex];
-                  output[ch][sampleIndex] += sample / oversampling;
-                  if (ch < 2)
-                     mGlobalRecordBuffer->Write(sample, ch);
-               }
-            }
+            output[ch][sampleIndex] = 0;
+            for (int subsampleIndex = 0; subsampleIndex < oversampling; ++subsampleIndex)
+               output[ch][sampleIndex] += src[sampleIndex * oversampling + subsampleIndex] / oversampling;
          }
       }
    }
 
+   if (mUseIOFifo)
+   {
+      for (auto& fifo : mOutputFifo)
+         std::copy(fifo.data() + ioBufferSize, fifo.data() + mOutputFifoCount, fifo.data());
+      mOutputFifoCount -= ioBufferSize;
+   }
+
    /////////// AUDIO PROCESSING ENDS HERE /////////////
-   mRecordingLength += bufferSize * oversampling;
-   mRecordingLength = MIN(mRecordingLength, mGlobalRecordBuffer->Size());
+   RealtimeSafetyMonitor::ClearContext();
 
    Profiler::PrintCounters();
 }
 
+void ModularSynth::RenderBlock()
+{
+   //timed per block rather than per device callback, since with the fifo engaged a callback can render zero or several blocks.
+   //we're already holding the audio lock here, so time spent waiting on the main thread isn't counted as load.
+   CpuGovernor::BeginBlock();
+
+   for (size_t i = 0; i < mOutputBuffers.size(); ++i)
+      Clear(mOutputBuffers[i], gBufferSize);
+
+   gTime += gBufferSizeMs;
+   RealtimeSafetyMonitor::SetContext("transport");
+   TheTransport->Advance(gBufferSizeMs);
+
+   //process all audio
+   for (int i = 0; i < mSources.size(); ++i)
+   {
+      RealtimeSafetyMonitor::SetContextSource(mSources[i]);
+      mSources[i]->ProcessBlock(gTime);
+   }
+   RealtimeSafetyMonitor::SetContext("output");
+
+   if (gTime - mLastClapboardTime < 100)
+   {
+      for (size_t ch = 0; ch < mOutputBuffers.size(); ++ch)
+      {
+         for (int i = 0; i < gBufferSize; ++i)
+         {
+            float sample = sin(GetPhaseInc(440) * i) * (1 - ((gTime - mLastClapboardTime) / 100));
+            mOutputBuffers[ch][i] = sample;
+         }
+      }
+   }
+
+   if (!mSavingOutput)
+   {
+      for (size_t ch = 0; ch < mOutputBuffers.size() && ch < 2; ++ch)
+         mGlobalRecordBuffer->WriteChunk(mOutputBuffers[ch], gBufferSize, ch);
+      mRecordingLength += gBufferSize;
+      mRecordingLength = MIN(mRecordingLength, mGlobalRecordBuffer->Size());
+   }
+
+   CpuGovernor::EndBlock(gInvSampleRateMs * gBufferSize);
+}
+
+void ModularSynth::EngageIOFifo()
+{
+   if (mUseIOFifo)
+      return;
+
+   //a block of silence ahead of the input means every block we render has a full block of input to read, whatever sizes the device hands us
+   for (auto& fifo : mInputFifo)
+      Clear(fifo.data(), gBufferSize);
+   mInputFifoCount = gBufferSize;
+   mOutputFifoCount = 0;
+   mUseIOFifo = true;
+}
+
 void ModularSynth::AudioIn(const float* const* input, int bufferSize, int nChannels)
 {
    if (mAudioPaused)
@@ -2075,24 +2166,31 @@ void ModularSynth::AudioIn(const float* const* input, int bufferSize, int nChann
    ScopedMutex mutex(&mAudioThreadMutex, "audioIn()");
 
    int oversampling = UserPrefs.oversampling.Get();
+   int ioBufferSize = bufferSize * oversampling;
 
-   assert(bufferSize * oversampling == mIOBufferSize);
    assert(nChannels == (int)mInputBuffers.size());
+   if (ioBufferSize != gBufferSize)
+      EngageIOFifo();
+
+   if (mUseIOFifo && nChannels > 0 && mInputFifoCount + ioBufferSize > (int)mInputFifo[0].size())
+      return; //larger than we can adapt to, AudioOut() will output silence
 
    for (int i = 0; i < nChannels; ++i)
    {
+      float* dest = mUseIOFifo ? mInputFifo[i].data() + mInputFifoCount : mInputBuffers[i];
       if (oversampling == 1)
       {
-         BufferCopy(mInputBuffers[i], input[i], bufferSize);
+         BufferCopy(dest, input[i], bufferSize);
       }
       else
       {
-         for (int sampleIndex = 0; sampleIndex < bufferSize * oversampling; ++sampleIndex)
-         {
-            mInputBuffers[i][sampleIndex] = input[i][sampleIndex / oversampling];
-         }
+         for (int sampleIndex = 0; sampleIndex < ioBufferSize; ++sampleIndex)
+            dest[sampleIndex] = input[i][sampleIndex / oversampling];
       }
    }
+
+   if (mUseIOFifo)
+      mInputFifoCount += ioBufferSize;
 }
 
 float* ModularSynth::GetInputBuffer(int channel)
@@ -2482,7 +2580,7 @@ bool ModularSynth::LoadLayoutFromString(std::string jsonString)
    return true;
 }
 
-void ModularSynth::LoadLayout(ofxJSONElement json)
+void ModularSynth::LoadLayout(const ofxJSONElement& json)
 {
    ScriptModule::UninitializePython();
    Transport::sDoEventLookahead = false;
@@ -2647,9 +2745,47 @@ IUIControl* ModularSynth::FindUIControl(std::string path)
    {
       if (Prefab::sLoadingPrefab)
          return nullptr;
-      return mModuleContainer.FindUIControl(path.substr(1, path.length() - 1));
+      path = path.substr(1, path.length() - 1);
    }
-   return mModuleContainer.FindUIControl(IClickable::sPathLoadContext + path);
+   else
+   {
+      path = IClickable::sPathLoadContext + path;
+   }
+
+   //OSC, scripts and midi mappings resolve the same paths over and over, so remember them until anything that paths go through changes
+   std::lock_guard<ofMutex> lock(mUIControlPathCacheMutex);
+   if (mUIControlPathCacheGeneration != IClickable::GetPathGeneration())
+   {
+      mUIControlPathCache.clear();
+      mUIControlPathCacheGeneration = IClickable::GetPathGeneration();
+   }
+
+   auto cached = mUIControlPathCache.find(path);
+   if (cached != mUIControlPathCache.end())
+      return cached->second;
+
+   IUIControl* control = mModuleContainer.FindUIControl(path);
+   if (control != nullptr)
+   {
+      if (mUIControlPathCacheGeneration != IClickable::GetPathGeneration()) //resolving can create controls
+      {
+         mUIControlPathCache.clear();
+         mUIControlPathCacheGeneration = IClickable::GetPathGeneration();
+      }
+      mUIControlPathCache[path] = control;
+   }
+   return control;
+}
+
+IUIControl* ModularSynth::FindCachedUIControl(const std::string& path)
+{
+   std::lock_guard<ofMutex> lock(mUIControlPathCacheMutex);
+   if (mUIControlPathCacheGeneration != IClickable::GetPathGeneration())
+      return nullptr;
+   auto cached = mUIControlPathCache.find(path);
+   if (cached != mUIControlPathCache.end())
+      return cached->second;
+   return nullptr;
 }
 
 void ModularSynth::GrabSample(ChannelBuffer* data, std::string name, bool window, int numBars)
@@ -2676,6 +2812,7 @@ void ModularSynth::GrabSample(ChannelBuffer* data, std::string name, bool window
                mHeldSample->Data()->GetChannel(ch)[length - 1 - i] *= fade;
             }
          }
+         mHeldSample->Data()->InvalidatePeaks();
       }
    }
 }
@@ -2830,21 +2967,20 @@ void ModularSynth::SaveState(std::string file, bool autosave)
 
    mAudioThreadMutex.Lock("SaveState()");
 
-   //write to a temp file first, so we don't corrupt data if we crash mid-save
-   std::string tmpFilePath = ofToDataPath("tmp");
-
+   //FileStreamOut writes to a temp file next to the target and only swaps it in once everything is written, so we don't corrupt data if we crash mid-save
    {
-      FileStreamOut out(tmpFilePath);
+      FileStreamOut out(file);
+      out.BeginChunkedFile();
 
       mZoomer.WriteCurrentLocation(-1);
+      out.BeginChunk("layout");
       out << GetLayout().getRawString(true);
+      out.EndChunk();
       mModuleContainer.SaveState(out);
       mUILayerModuleContainer.SaveState(out);
-   }
 
-   juce::File writtenFile(tmpFilePath);
-   juce::File targetFile(file);
-   writtenFile.copyFileTo(targetFile);
+      out.EndChunkedFile();
+   }
 
    mAudioThreadMutex.Unlock();
 }
@@ -2882,13 +3018,22 @@ void ModularSynth::LoadState(std::string file)
    LockRender(false);
    mAudioThreadMutex.Unlock();
 
-   //TODO(Ryan) here's a little hack to allow older BSK files that were saved in 32-bit to load.
-   //I guess this could bite me if someone ever has a very massive json. the number corresponds to a long-standing sanity check in FileStreamIn::operator>>(std::string &var), so this shouldn't break any current behavior.
-   //this should definitely be removed if anything about the structure of the BSK format changes.
-   uint64_t firstLength[1];
-   in.Peek(firstLength, sizeof(uint64_t));
-   if (firstLength[0] >= FileStreamIn::sMaxStringLength)
-      FileStreamIn::s32BitMode = true;
+   if (in.ReadChunkedFileHeader())
+   {
+      const FileStreamChunk* layoutChunk = in.GetChunkAtPosition();
+      if (layoutChunk != nullptr && !in.VerifyChunk(*layoutChunk))
+         LogEvent("layout in " + file + " is corrupt (checksum mismatch), trying to load it anyway", kLogEventType_Error);
+   }
+   else
+   {
+      //TODO(Ryan) here's a little hack to allow older BSK files that were saved in 32-bit to load.
+      //I guess this could bite me if someone ever has a very massive json. the number corresponds to a long-standing sanity check in FileStreamIn::operator>>(std::string &var), so this shouldn't break any current behavior.
+      //this should definitely be removed if anything about the structure of the BSK format changes.
+      uint64_t firstLength[1];
+      in.Peek(firstLength, sizeof(uint64_t));
+      if (firstLength[0] >= FileStreamIn::sMaxStringLength)
+         FileStreamIn::s32BitMode = true;
+   }
 
    std::string jsonString;
    in >> jsonString;
@@ -3014,6 +3159,25 @@ void ModularSynth::OnConsoleInput(std::string command /* = "" */)
       {
          Profiler::ToggleProfiler();
       }
+      else if (tokens[0] == "realtimecheck")
+      {
+         RealtimeSafetyMonitor::ToggleMonitor();
+         ofLog() << "realtime safety monitor " << (RealtimeSafetyMonitor::IsEnabled() ? "enabled" : "disabled");
+      }
+      else if (tokens[0] == "poolstats")
+      {
+         RealtimePool::LogStats();
+      }
+      else if (tokens[0] == "realtimereport")
+      {
+         std::string path = ofToDataPath("realtime_safety_report.txt");
+         if (tokens.size() >= 2)
+            path = ofToDataPath(tokens[1]);
+         if (RealtimeSafetyMonitor::WriteReport(path))
+            ofLog() << "wrote " << path;
+         else
+            LogEvent("couldn't write " + path, kLogEventType_Error);
+      }
       else if (tokens[0] == "clear")
       {
          mErrors.clear();
@@ -3272,7 +3436,14 @@ void ModularSynth::ReconnectMidiDevices()
 
 void ModularSynth::SaveOutput()
 {
-   ScopedMutex mutex(&mAudioThreadMutex, "SaveOutput()");
+   if (mSavingOutput)
+   {
+      TheTitleBar->DisplayTemporaryMessage("still writing previous recording");
+      return;
+   }
+
+   if (mSaveOutputThread.joinable())
+      mSaveOutputThread.join();
 
    std::string save_prefix = "recording_";
    if (!mCurrentSaveStatePath.empty())
@@ -3285,7 +3456,21 @@ void ModularSynth::SaveOutput()
    std::string filename = ofGetTimestampString(UserPrefs.recordings_path.Get() + save_prefix + "%Y-%m-%d_%H-%M.wav");
    //string filenamePos = ofGetTimestampString("recordings/pos_%Y-%m-%d_%H-%M.wav");
 
-   assert(mRecordingLength <= mGlobalRecordBuffer->Size());
+   long long recordingLength;
+   {
+      //only hold the audio lock long enough to freeze the record buffer, the file gets written in the background
+      ScopedMutex mutex(&mAudioThreadMutex, "SaveOutput()");
+      mSavingOutput = true;
+      recordingLength = mRecordingLength;
+   }
+
+   TheTitleBar->DisplayTemporaryMessage("writing " + filename);
+   mSaveOutputThread = std::thread(&ModularSynth::WriteRecordBuffer, this, filename, recordingLength);
+}
+
+void ModularSynth::WriteRecordBuffer(std::string filename, long long recordingLength)
+{
+   assert(recordingLength <= mGlobalRecordBuffer->Size());
 
    int channels = 2;
    auto wavFormat = std::make_unique<juce::WavAudioFormat>();
@@ -3296,27 +3481,28 @@ void ModularSynth::SaveOutput()
    bool b1{ false };
    auto writer = std::unique_ptr<juce::AudioFormatWriter>(wavFormat->createWriterFor(outputTo.release(), gSampleRate, channels, 16, b1, 0));
 
-   long long samplesRemaining = mRecordingLength;
-   const int chunkSize = 256;
-   float leftChannel[chunkSize];
-   float rightChannel[chunkSize];
-   float* chunk[2]{ leftChannel, rightChannel };
+   long long samplesRemaining = recordingLength;
+   const int chunkSize = 8192;
+   std::vector<float> leftChannel(chunkSize);
+   std::vector<float> rightChannel(chunkSize);
+   float* chunk[2]{ leftChannel.data(), rightChannel.data() };
    while (samplesRemaining > 0)
    {
-      int numSamples = MIN(chunkSize, samplesRemaining);
-      for (int i = 0; i < numSamples; ++i)
-      {
-         chunk[0][i] = mGlobalRecordBuffer->GetSample(samplesRemaining - 1, 0);
-         chunk[1][i] = mGlobalRecordBuffer->GetSample(samplesRemaining - 1, 1);
-         --samplesRemaining;
-      }
+      int numSamples = (int)MIN(chunkSize, samplesRemaining);
+      samplesRemaining -= numSamples;
+      mGlobalRecordBuffer->ReadChunk(chunk[0], numSamples, (int)samplesRemaining, 0);
+      mGlobalRecordBuffer->ReadChunk(chunk[1], numSamples, (int)samplesRemaining, 1);
       writer->writeFromFloatArrays(chunk, channels, numSamples);
    }
+   writer.reset();
 
+   //the audio thread doesn't touch the record buffer until mSavingOutput is cleared
    mGlobalRecordBuffer->ClearBuffer();
    mRecordingLength = 0;
+   mSavingOutput = false;
 
-   TheTitleBar->DisplayTemporaryMessage("wrote " + filename);
+   juce::MessageManager::callAsync([filename]()
+                                   { TheTitleBar->DisplayTemporaryMessage("wrote " + filename); });
 }
 
 const String& ModularSynth::GetTextFromClipboard() const
@@ -16,6 +16,8 @@
 #include "ModuleContainer.h"
 #include "Minimap.h"
 #include <thread>
+#include <atomic>
+#include <unordered_map>
 
 #ifdef BESPOKE_LINUX
 #include <climits>
@@ -104,6 +106,8 @@ public:
 
    void AudioOut(float* const* output, int bufferSize, int nChannels);
    void AudioIn(const float* const* input, int bufferSize, int nChannels);
+   int GetDeviceBufferSize() const { return mDeviceBufferSize; }
+   static const int kMaxFifoDeviceBufferSize = 8192; //largest device buffer we can adapt to when it doesn't match the engine's block size
 
    void OnConsoleInput(std::string command = "");
    void ClearConsoleInput();
@@ -127,6 +131,7 @@ public:
    IAudioReceiver* FindAudioReceiver(std::string name, bool fail = false);
    INoteReceiver* FindNoteReceiver(std::string name, bool fail = false);
    IUIControl* FindUIControl(std::string path);
+   IUIControl* FindCachedUIControl(const std::string& path); //only returns controls that FindUIControl() has already resolved, safe to call off the main thread but takes a lock, so keep it off the audio thread
    MidiController* FindMidiController(std::string name, bool fail = false);
    void MoveToFront(IDrawableModule* module);
    bool InMidiMapMode();
@@ -143,7 +148,7 @@ public:
 
    bool LoadLayoutFromFile(std::string jsonFile, bool makeDefaultLayout = true);
    bool LoadLayoutFromString(std::string jsonString);
-   void LoadLayout(ofxJSONElement json);
+   void LoadLayout(const ofxJSONElement& json);
    std::string GetLoadedLayout() const { return mLoadedLayoutPath; }
    void ReloadInitialLayout() { mWantReloadInitialLayout = true; }
    bool HasFatalError() { return mFatalError != ""; }
@@ -261,6 +266,7 @@ public:
    ofxJSONElement GetLayout();
    void SaveLayoutAsPopup();
    void SaveOutput();
+   void WriteRecordBuffer(std::string filename, long long recordingLength);
    void SaveState(std::string file, bool autosave);
    void LoadState(std::string file);
    void SetStartupSaveStateFile(std::string bskPath);
@@ -309,7 +315,10 @@ private:
 
    void ReadClipboardTextFromSystem();
 
-   int mIOBufferSize{ 0 };
+   void RenderBlock();
+   void EngageIOFifo();
+
+   int mDeviceBufferSize{ 0 }; //what we asked the audio device for, which doesn't have to match gBufferSize
 
    std::vector<IAudioSource*> mSources;
    std::vector<IDrawableModule*> mLissajousDrawers;
@@ -351,6 +360,8 @@ private:
 
    RollingBuffer* mGlobalRecordBuffer{ nullptr };
    long long mRecordingLength{ 0 };
+   std::atomic<bool> mSavingOutput{ false }; //audio thread stops feeding mGlobalRecordBuffer while it is written out
+   std::thread mSaveOutputThread;
 
    struct LogEventItem
    {
@@ -420,6 +431,12 @@ private:
    juce::OpenGLContext* mOpenGLContext{ nullptr };
 
    std::recursive_mutex mRenderLock;
+
+   //resolved FindUIControl() paths, thrown away whenever IClickable::GetPathGeneration() moves on
+   std::unordered_map<std::string, IUIControl*> mUIControlPathCache;
+   int mUIControlPathCacheGeneration{ -1 };
+   ofMutex mUIControlPathCacheMutex;
+
    float mFrameRate{ 0 };
    long mFrameCount{ 0 };
 
@@ -442,6 +459,14 @@ private:
    std::vector<float*> mInputBuffers;
    std::vector<float*> mOutputBuffers;
 
+   //used once the device's buffers stop lining up with gBufferSize. the engine then renders whole blocks, buffering input until a block's worth
+   //has arrived and output until the device asks for it
+   bool mUseIOFifo{ false };
+   std::vector<std::vector<float>> mInputFifo;
+   std::vector<std::vector<float>> mOutputFifo;
+   int mInputFifoCount{ 0 };
+   int mOutputFifoCount{ 0 };
+
    std::unique_ptr<juce::AudioPluginFormatManager> mAudioPluginFormatManager;
    std::unique_ptr<juce::KnownPluginList> mKnownPluginList;
 };
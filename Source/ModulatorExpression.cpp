@@ -91,8 +91,21 @@ float ModulatorExpression::Value(int samplesIn)
    ComputeSliders(samplesIn);
    if (mExpressionValid)
    {
-      mT = (gTime + samplesIn * gInvSampleRateMs) * .001;
-      return mExpression.value();
+      if (mExpressionReadsTime)
+         mT = (gTime + samplesIn * gInvSampleRateMs) * .001;
+
+      if (!mCanCacheValue)
+         return mExpression.value();
+
+      //this gets pulled every sample, but the inputs usually sit still for long stretches
+      std::array<float, 6> inputs{ mExpressionInput, mA, mB, mC, mD, mE };
+      if (!mCachedValueValid || inputs != mCachedInputs)
+      {
+         mCachedInputs = inputs;
+         mCachedValue = mExpression.value();
+         mCachedValueValid = true;
+      }
+      return mCachedValue;
    }
 
    if (GetSliderTarget())
@@ -114,10 +127,15 @@ void ModulatorExpression::PostRepatch(PatchCableSource* cableSource, bool fromUs
 void ModulatorExpression::TextEntryComplete(TextEntry* entry)
 {
    mExpressionValid = false;
-   exprtk::parser<float> parser;
-   mExpressionValid = parser.compile(mEntryString, mExpression);
+   mCachedValueValid = false;
+   mExpressionValid = mCurve.Compile(mEntryString, mExpression);
    if (mExpressionValid)
+   {
+      exprtk::parser<float> parser;
       parser.compile(mEntryString, mExpressionDraw);
+      mExpressionReadsTime = mCurve.Reads("t");
+      mCanCacheValue = !mExpressionReadsTime && !mCurve.HasAssignments();
+   }
 }
 
 void ModulatorExpression::DrawModule()
@@ -32,7 +32,7 @@
 #include "Slider.h"
 #include "ClickButton.h"
 #include "TextEntry.h"
-#include "exprtk/exprtk.hpp"
+#include "ExpressionCurve.h"
 
 class ModulatorExpression : public IDrawableModule, public IFloatSliderListener, public ITextEntryListener, public IModulator
 {
@@ -92,6 +92,12 @@ private:
    float mExpressionInputDraw{ 0 };
    float mT{ 0 };
    bool mExpressionValid{ false };
+   ExpressionCurve mCurve;
+   bool mExpressionReadsTime{ false };
+   bool mCanCacheValue{ false };
+   std::array<float, 6> mCachedInputs{};
+   float mCachedValue{ 0 };
+   bool mCachedValueValid{ false };
    float mLastDrawMinOutput{ 0 };
    float mLastDrawMaxOutput{ 1 };
 };
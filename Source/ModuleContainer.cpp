@@ -69,15 +69,20 @@ void ModuleContainer::DrawContents()
 
 void ModuleContainer::DrawModules()
 {
+   //only the main canvas shares coordinates with the synth's draw rect, so that's the only place we can reject offscreen modules
+   bool cullOffscreen = (this == TheSynth->GetRootContainer());
+   ofRectangle visibleRect = TheSynth->GetDrawRect();
+   visibleRect.grow(kOffscreenCullMargin);
+
    for (int i = (int)mModules.size() - 1; i >= 0; --i)
    {
-      if (!mModules[i]->AlwaysOnTop())
+      if (!mModules[i]->AlwaysOnTop() && (!cullOffscreen || mModules[i]->IsWithinRect(visibleRect)))
          mModules[i]->Draw();
    }
 
    for (int i = (int)mModules.size() - 1; i >= 0; --i)
    {
-      if (mModules[i]->AlwaysOnTop())
+      if (mModules[i]->AlwaysOnTop() && (!cullOffscreen || mModules[i]->IsWithinRect(visibleRect)))
          mModules[i]->Draw();
    }
 }
@@ -301,6 +306,7 @@ void ModuleContainer::MoveToFront(IDrawableModule* module)
 
 void ModuleContainer::AddModule(IDrawableModule* module)
 {
+   IClickable::InvalidatePaths();
    mModules.push_back(module);
    MoveToFront(module);
    TheSynth->OnModuleAdded(module);
@@ -312,6 +318,7 @@ void ModuleContainer::AddModule(IDrawableModule* module)
 void ModuleContainer::TakeModule(IDrawableModule* module)
 {
    assert(module->GetOwningContainer()); //module must already be in a container
+   IClickable::InvalidatePaths();
    ofVec2f oldOwnerPos = module->GetOwningContainer()->GetOwnerPosition();
    if (module->GetOwningContainer()->mOwner)
       module->GetOwningContainer()->mOwner->RemoveChild(module);
@@ -337,6 +344,8 @@ void ModuleContainer::DeleteModule(IDrawableModule* module, bool fail /*= true*/
    if (!module->CanBeDeleted())
       return;
 
+   IClickable::InvalidatePaths();
+
    if (module->HasSpecialDelete())
    {
       module->DoSpecialDelete();
@@ -417,11 +426,11 @@ IDrawableModule* ModuleContainer::FindModule(std::string name, bool fail)
    if (name == "")
       return nullptr;
 
+   std::vector<std::string> tokens = ofSplitString(name, "~");
    for (int i = 0; i < mModules.size(); ++i)
    {
       if (name == mModules[i]->Name())
          return mModules[i];
-      std::vector<std::string> tokens = ofSplitString(name, "~");
       if (mModules[i]->GetContainer())
       {
          if (tokens[0] == mModules[i]->Name())
@@ -510,6 +519,10 @@ void ModuleContainer::LoadModules(const ofxJSONElement& modules)
 
       if (mOwner)
          IClickable::SetLoadContext(mOwner);
+
+      //remember what each json entry created, so the setup pass doesn't need to search the container for every module
+      std::vector<IDrawableModule*> createdModules(modules.size(), nullptr);
+
       {
          TimerInstance t("create", timer);
          for (int i = 0; i < modules.size(); ++i)
@@ -522,6 +535,7 @@ void ModuleContainer::LoadModules(const ofxJSONElement& modules)
                {
                   //ofLog() << "create " << module->Name();
                   AddModule(module);
+                  createdModules[i] = module;
                }
             }
             catch (LoadingJSONException& e)
@@ -538,7 +552,9 @@ void ModuleContainer::LoadModules(const ofxJSONElement& modules)
             try
             {
                TimerInstance t("setup " + modules[i]["name"].asString(), timer);
-               IDrawableModule* module = FindModule(modules[i]["name"].asString(), true);
+               IDrawableModule* module = createdModules[i];
+               if (module == nullptr || modules[i]["name"].asString() != module->Name())
+                  module = FindModule(modules[i]["name"].asString(), true);
                if (module != nullptr)
                {
                   //ofLog() << "setup " << module->Name();
@@ -629,10 +645,13 @@ void ModuleContainer::SaveState(FileStreamOut& out)
       if (module->IsSaveable())
       {
          //ofLog() << "Saving " << module->Name();
+         bool chunked = out.BeginChunk(module->Name()); //only top-level modules of a chunked file get their own chunk
          out << std::string(module->Name());
          module->SaveState(out);
          for (int i = 0; i < GetModuleSeparatorLength(); ++i)
             out << GetModuleSeparator()[i];
+         if (chunked)
+            out.EndChunk();
       }
    }
 
@@ -663,6 +682,14 @@ void ModuleContainer::LoadState(FileStreamIn& in)
 
    for (int i = 0; i < savedModules; ++i)
    {
+      const FileStreamChunk* chunk = in.GetChunkAtPosition();
+      if (chunk != nullptr && !in.VerifyChunk(*chunk))
+      {
+         TheSynth->LogEvent("Saved state for module \"" + chunk->mName + "\" is corrupt (checksum mismatch), skipping it", kLogEventType_Error);
+         in.SkipChunk(*chunk);
+         continue;
+      }
+
       std::string moduleName;
       in >> moduleName;
       //ofLog() << "Loading " << moduleName;
@@ -700,6 +727,12 @@ void ModuleContainer::LoadState(FileStreamIn& in)
       {
          TheSynth->LogEvent("Error loading state for module \"" + moduleName + "\"", kLogEventType_Error);
 
+         if (chunk != nullptr)
+         {
+            in.SkipChunk(*chunk);
+            continue;
+         }
+
          //read through the rest of the module until we find the spacer, so we can continue loading the next module
          int separatorProgress = 0;
          juce::uint64 safetyCheck = 0;
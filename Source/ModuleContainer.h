@@ -93,6 +93,8 @@ public:
    static const char* GetModuleSeparator() { return "ryanchallinor"; }
    static bool DoesModuleHaveMoreSaveData(FileStreamIn& in);
 
+   static constexpr float kOffscreenCullMargin = 20; //extra space around the visible area so highlights and outlines don't pop
+
 private:
    std::vector<IDrawableModule*> mModules;
    IDrawableModule* mOwner{ nullptr };
@@ -262,6 +262,7 @@
 #include "PitchToValue.h"
 #include "RhythmSequencer.h"
 #include "DotSequencer.h"
+#include "UserPrefs.h"
 
 #include <juce_core/juce_core.h>
 
@@ -565,127 +566,270 @@ std::vector<ModuleFactory::Spawnable> ModuleFactory::GetSpawnableModules(ModuleC
 
 namespace
 {
-   bool CheckHeldKeysMatch(juce::String name, std::string heldKeys, bool continuous)
+   //name is expected to be lowercase already
+   bool CheckHeldKeysMatch(const std::string& name, const std::string& heldKeys, bool continuous)
    {
-      name = name.toLowerCase();
-
-      if (name.isEmpty() || heldKeys.empty())
+      if (name.empty() || heldKeys.empty())
          return false;
 
       if (continuous)
-         return name.contains(heldKeys);
+         return name.find(heldKeys) != std::string::npos;
 
       if (name[0] != heldKeys[0])
          return false;
 
-      int stringPos = 0;
-      int end = name.indexOfChar('.');
-      if (end == -1)
-         end = name.indexOfChar(' ');
-      if (end == -1)
+      //each following key has to appear, in order, within the first word
+      size_t end = name.find('.');
+      if (end == std::string::npos)
+         end = name.find(' ');
+      if (end == std::string::npos)
          end = name.length() - 1;
-      bool showModule = true;
+      size_t stop = MIN(end + 1, name.length());
+      size_t stringPos = 0;
       for (size_t j = 1; j < heldKeys.length(); ++j)
       {
-         stringPos = name.substring(stringPos + 1, end + 1).indexOfChar(heldKeys[j]);
-         if (stringPos == -1) //couldn't find key in remaining string
+         size_t start = stringPos + 1;
+         if (start >= stop)
+            return false;
+         size_t found = name.find(heldKeys[j], start);
+         if (found == std::string::npos || found >= stop) //couldn't find key in remaining string
             return false;
+         stringPos = found - start;
       }
 
       return true;
    }
+
+   uint64_t GetCharMask(const std::string& str)
+   {
+      uint64_t mask = 0;
+      for (char c : str)
+         mask |= uint64_t(1) << (c & 63);
+      return mask;
+   }
 }
 
 std::vector<ModuleFactory::Spawnable> ModuleFactory::GetSpawnableModules(std::string keys, bool continuousString)
 {
    std::vector<ModuleFactory::Spawnable> modules{};
-   for (auto iter = mFactoryMap.begin(); iter != mFactoryMap.end(); ++iter)
+   if (keys.empty())
+      return modules;
+
+   if (mSpawnCatalogDirty)
+      BuildSpawnCatalog();
+
+   bool prefabsAndPresetsOnly = keys[0] == ';';
+
+   //typing another character can only narrow down the previous results, so only those need to be checked again
+   bool refine = !mLastSpawnQuery.empty() &&
+                 continuousString == mLastSpawnQueryContinuous &&
+                 keys.length() > mLastSpawnQuery.length() &&
+                 keys.compare(0, mLastSpawnQuery.length(), mLastSpawnQuery) == 0;
+
+   std::vector<int> matches;
+   auto checkCandidates = [&](const std::vector<int>& candidates)
    {
-      if ((!iter->second.mIsHidden || gShowDevModules) &&
-          CheckHeldKeysMatch(iter->first, keys, continuousString))
+      uint64_t keysMask = GetCharMask(keys);
+      for (int index : candidates)
       {
-         ModuleFactory::Spawnable spawnable{};
-         spawnable.mLabel = iter->first;
-         modules.push_back(spawnable);
+         const SpawnCatalogEntry& entry = mSpawnCatalog[index];
+         bool isPrefabOrPreset = entry.mSpawnable.mSpawnMethod == SpawnMethod::Prefab || entry.mSpawnable.mSpawnMethod == SpawnMethod::Preset;
+         if ((prefabsAndPresetsOnly && isPrefabOrPreset) ||
+             ((entry.mCharMask & keysMask) == keysMask && CheckHeldKeysMatch(entry.mLowerLabel, keys, continuousString)))
+            matches.push_back(index);
       }
-   }
+   };
 
-   std::vector<juce::PluginDescription> vsts;
-   VSTLookup::GetAvailableVSTs(vsts);
-   std::vector<juce::PluginDescription> matchingVsts;
-   for (auto& pluginDesc : vsts)
+   if (refine)
+   {
+      checkCandidates(mLastSpawnQueryMatches);
+   }
+   else if (!continuousString && prefabsAndPresetsOnly)
+   {
+      checkCandidates(mSpawnCatalogPrefabsAndPresets);
+   }
+   else if (!continuousString)
    {
-      std::string pluginName = pluginDesc.name.toStdString();
-      if (CheckHeldKeysMatch(pluginName, keys, continuousString))
-         matchingVsts.push_back(pluginDesc);
+      unsigned char firstChar = keys[0];
+      if (firstChar < mSpawnCatalogByFirstChar.size())
+         checkCandidates(mSpawnCatalogByFirstChar[firstChar]);
    }
+   else
+   {
+      std::vector<int> all(mSpawnCatalog.size());
+      for (size_t i = 0; i < all.size(); ++i)
+         all[i] = (int)i;
+      checkCandidates(all);
+   }
+
+   mLastSpawnQuery = keys;
+   mLastSpawnQueryContinuous = continuousString;
+   mLastSpawnQueryMatches = matches;
+
+   //plugins are cataloged most recently used first, so this keeps the most relevant ones
    const int kMaxQuickspawnVstCount = 10;
-   if ((int)matchingVsts.size() > kMaxQuickspawnVstCount)
-      VSTLookup::SortByLastUsed(matchingVsts);
+   int vstCount = 0;
+   std::vector<int> results;
+   results.reserve(matches.size());
+   for (int index : matches)
+   {
+      const SpawnCatalogEntry& entry = mSpawnCatalog[index];
+      if (entry.mIsHidden && !gShowDevModules)
+         continue;
+      if (entry.mSpawnable.mSpawnMethod == SpawnMethod::Plugin && vstCount++ >= kMaxQuickspawnVstCount)
+         continue;
+      results.push_back(index);
+   }
+
+   if (continuousString)
+      std::sort(results.begin(), results.end(), [this](int a, int b) { return mSpawnCatalog[a].mLengthRank < mSpawnCatalog[b].mLengthRank; });
+   else
+      std::sort(results.begin(), results.end(), [this](int a, int b) { return mSpawnCatalog[a].mAlphabeticalRank < mSpawnCatalog[b].mAlphabeticalRank; });
+
+   modules.reserve(results.size());
+   for (int index : results)
+      modules.push_back(mSpawnCatalog[index].mSpawnable);
+
+   return modules;
+}
+
+void ModuleFactory::UpdateSpawnCatalog()
+{
+   uint64_t stamp = GetSpawnCatalogSourcesStamp();
+   if (stamp != mSpawnCatalogSourcesStamp)
+   {
+      mSpawnCatalogSourcesStamp = stamp;
+      mSpawnCatalogDirty = true;
+   }
+
+   if (mSpawnCatalogDirty)
+      BuildSpawnCatalog();
+}
 
-   for (int i = 0; i < (int)matchingVsts.size() && i < kMaxQuickspawnVstCount; ++i)
+void ModuleFactory::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+   //the known plugin list changed, probably from a scan
+   mSpawnCatalogDirty = true;
+}
+
+void ModuleFactory::BuildSpawnCatalog()
+{
+   mSpawnCatalog.clear();
+   for (auto& bucket : mSpawnCatalogByFirstChar)
+      bucket.clear();
+   mSpawnCatalogPrefabsAndPresets.clear();
+   mLastSpawnQuery.clear();
+   mLastSpawnQueryMatches.clear();
+
+   for (auto iter = mFactoryMap.begin(); iter != mFactoryMap.end(); ++iter)
+   {
+      ModuleFactory::Spawnable spawnable{};
+      spawnable.mLabel = iter->first;
+      AddToSpawnCatalog(spawnable, iter->second.mIsHidden);
+   }
+
+   std::vector<juce::PluginDescription> vsts;
+   VSTLookup::GetAvailableVSTs(vsts);
+   VSTLookup::SortByLastUsed(vsts);
+   for (auto& pluginDesc : vsts)
    {
       ModuleFactory::Spawnable spawnable{};
-      auto& pluginDesc = matchingVsts[i];
       spawnable.mLabel = pluginDesc.name.toStdString();
       spawnable.mDecorator = "[" + ModuleFactory::Spawnable::GetPluginLabel(pluginDesc) + "]";
       spawnable.mPluginDesc = pluginDesc;
       spawnable.mSpawnMethod = SpawnMethod::Plugin;
-      modules.push_back(spawnable);
+      AddToSpawnCatalog(spawnable, false);
    }
 
    std::vector<Spawnable> prefabs;
    ModuleFactory::GetPrefabs(prefabs);
-   for (auto prefab : prefabs)
-   {
-      if (CheckHeldKeysMatch(prefab.mLabel, keys, continuousString) || keys[0] == ';')
-         modules.push_back(prefab);
-   }
+   for (const auto& prefab : prefabs)
+      AddToSpawnCatalog(prefab, false);
 
    std::vector<std::string> midicontrollers = MidiController::GetAvailableInputDevices();
-   for (auto midicontroller : midicontrollers)
+   for (const auto& midicontroller : midicontrollers)
    {
-      if (CheckHeldKeysMatch(midicontroller, keys, continuousString))
-      {
-         ModuleFactory::Spawnable spawnable{};
-         spawnable.mLabel = midicontroller;
-         spawnable.mDecorator = kMidiControllerSuffix;
-         spawnable.mSpawnMethod = SpawnMethod::MidiController;
-         modules.push_back(spawnable);
-      }
+      ModuleFactory::Spawnable spawnable{};
+      spawnable.mLabel = midicontroller;
+      spawnable.mDecorator = kMidiControllerSuffix;
+      spawnable.mSpawnMethod = SpawnMethod::MidiController;
+      AddToSpawnCatalog(spawnable, false);
    }
 
    std::vector<std::string> effects = TheSynth->GetEffectFactory()->GetSpawnableEffects();
-   for (auto effect : effects)
+   for (const auto& effect : effects)
    {
-      if (CheckHeldKeysMatch(effect, keys, continuousString))
-      {
-         ModuleFactory::Spawnable spawnable{};
-         spawnable.mLabel = effect;
-         spawnable.mDecorator = kEffectChainSuffix;
-         spawnable.mSpawnMethod = SpawnMethod::EffectChain;
-         modules.push_back(spawnable);
-      }
+      ModuleFactory::Spawnable spawnable{};
+      spawnable.mLabel = effect;
+      spawnable.mDecorator = kEffectChainSuffix;
+      spawnable.mSpawnMethod = SpawnMethod::EffectChain;
+      AddToSpawnCatalog(spawnable, false);
    }
 
    std::vector<Spawnable> presets;
    ModuleFactory::GetPresets(presets);
-   for (auto preset : presets)
+   for (const auto& preset : presets)
+      AddToSpawnCatalog(preset, false);
+
+   //rank the entries once, so results only need to sort indices
+   std::vector<int> order(mSpawnCatalog.size());
+   for (size_t i = 0; i < order.size(); ++i)
+      order[i] = (int)i;
+   std::sort(order.begin(), order.end(), [this](int a, int b) { return Spawnable::CompareAlphabetical(mSpawnCatalog[a].mSpawnable, mSpawnCatalog[b].mSpawnable); });
+   for (size_t i = 0; i < order.size(); ++i)
+      mSpawnCatalog[order[i]].mAlphabeticalRank = (int)i;
+   std::sort(order.begin(), order.end(), [this](int a, int b) { return Spawnable::CompareLength(mSpawnCatalog[a].mSpawnable, mSpawnCatalog[b].mSpawnable); });
+   for (size_t i = 0; i < order.size(); ++i)
+      mSpawnCatalog[order[i]].mLengthRank = (int)i;
+
+   mSpawnCatalogDirty = false;
+}
+
+void ModuleFactory::AddToSpawnCatalog(const Spawnable& spawnable, bool hidden)
+{
+   SpawnCatalogEntry entry;
+   entry.mSpawnable = spawnable;
+   entry.mLowerLabel = juce::String(spawnable.mLabel).toLowerCase().toStdString();
+   entry.mCharMask = GetCharMask(entry.mLowerLabel);
+   entry.mIsHidden = hidden;
+
+   int index = (int)mSpawnCatalog.size();
+   mSpawnCatalog.push_back(entry);
+
+   if (!entry.mLowerLabel.empty())
    {
-      if (CheckHeldKeysMatch(preset.mLabel, keys, continuousString) || keys[0] == ';')
-         modules.push_back(preset);
+      unsigned char firstChar = entry.mLowerLabel[0];
+      if (firstChar < mSpawnCatalogByFirstChar.size())
+         mSpawnCatalogByFirstChar[firstChar].push_back(index);
    }
+   if (spawnable.mSpawnMethod == SpawnMethod::Prefab || spawnable.mSpawnMethod == SpawnMethod::Preset)
+      mSpawnCatalogPrefabsAndPresets.push_back(index);
+}
 
-   if (continuousString)
-      sort(modules.begin(), modules.end(), Spawnable::CompareLength);
-   else
-      sort(modules.begin(), modules.end(), Spawnable::CompareAlphabetical);
-
-   std::vector<ModuleFactory::Spawnable> ret;
-   for (size_t i = 0; i < modules.size(); ++i)
-      ret.push_back(modules[i]);
+//there's no portable way to get told about file changes, so compare modification times of everything the catalog is built from.
+//directories get a new modification time when files are added, removed or renamed in them.
+uint64_t ModuleFactory::GetSpawnCatalogSourcesStamp() const
+{
+   using namespace juce;
+   uint64_t stamp = 17;
+   auto addToStamp = [&stamp](int64 value)
+   {
+      stamp = stamp * 31 + (uint64_t)value;
+   };
 
-   return ret;
+   addToStamp(File(ofToDataPath("prefabs")).getLastModificationTime().toMilliseconds());
+   File presetsDir(ofToDataPath("presets"));
+   addToStamp(presetsDir.getLastModificationTime().toMilliseconds());
+   Array<File> directories;
+   presetsDir.findChildFiles(directories, File::findDirectories, false);
+   for (const auto& moduleDir : directories)
+      addToStamp(moduleDir.getLastModificationTime().toMilliseconds());
+   addToStamp(File(ofToDataPath("vst/recent_plugins.json")).getLastModificationTime().toMilliseconds());
+   addToStamp(String(UserPrefs.plugin_preference_order.Get()).hashCode64());
+   for (const auto& midicontroller : MidiController::GetAvailableInputDevices())
+      addToStamp(String(midicontroller).hashCode64());
+
+   return stamp;
 }
 
 ModuleCategory ModuleFactory::GetModuleCategory(std::string typeName)
@@ -27,6 +27,7 @@
 #define __modularSynth__ModuleFactory__
 
 #include <iostream>
+#include <array>
 #include "IDrawableModule.h"
 
 #include "juce_core/juce_core.h"
@@ -35,7 +36,7 @@
 typedef IDrawableModule* (*CreateModuleFn)(void);
 typedef bool (*CanCreateModuleFn)(void);
 
-class ModuleFactory
+class ModuleFactory : public juce::ChangeListener
 {
 public:
    ModuleFactory();
@@ -66,14 +67,14 @@ public:
          return pluginType;
       }
 
-      static bool CompareAlphabetical(Spawnable a, Spawnable b)
+      static bool CompareAlphabetical(const Spawnable& a, const Spawnable& b)
       {
          if (a.mLabel == b.mLabel)
             return a.mDecorator < b.mDecorator;
          return a.mLabel < b.mLabel;
       }
 
-      static bool CompareLength(Spawnable a, Spawnable b)
+      static bool CompareLength(const Spawnable& a, const Spawnable& b)
       {
          if (a.mLabel.length() == b.mLabel.length())
             return a.mDecorator.length() < b.mDecorator.length();
@@ -96,6 +97,8 @@ public:
    IDrawableModule* MakeModule(std::string type);
    std::vector<Spawnable> GetSpawnableModules(ModuleCategory moduleCategory);
    std::vector<Spawnable> GetSpawnableModules(std::string keys, bool continuousString);
+   void UpdateSpawnCatalog();
+   void MarkSpawnCatalogDirty() { mSpawnCatalogDirty = true; }
    ModuleCategory GetModuleCategory(std::string typeName);
    ModuleCategory GetModuleCategory(Spawnable spawnable);
    ModuleInfo GetModuleInfo(std::string typeName);
@@ -109,10 +112,36 @@ public:
    static constexpr const char* kMidiControllerSuffix = "[midicontroller]";
    static constexpr const char* kEffectChainSuffix = "[effectchain]";
 
+   //juce::ChangeListener
+   void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
 private:
+   struct SpawnCatalogEntry
+   {
+      Spawnable mSpawnable;
+      std::string mLowerLabel;
+      uint64_t mCharMask{ 0 };
+      bool mIsHidden{ false };
+      int mAlphabeticalRank{ 0 };
+      int mLengthRank{ 0 };
+   };
+
    void Register(std::string type, CreateModuleFn creator, CanCreateModuleFn canCreate, ModuleCategory moduleCategory, bool hidden, bool experimental, bool canReceiveAudio, bool canReceiveNotes, bool canReceivePulses);
+   void BuildSpawnCatalog();
+   void AddToSpawnCatalog(const Spawnable& spawnable, bool hidden);
+   uint64_t GetSpawnCatalogSourcesStamp() const;
 
    std::map<std::string, ModuleInfo> mFactoryMap;
+
+   //everything the quickspawn search looks through, built once and rebuilt when the sources change
+   std::vector<SpawnCatalogEntry> mSpawnCatalog;
+   std::array<std::vector<int>, 128> mSpawnCatalogByFirstChar;
+   std::vector<int> mSpawnCatalogPrefabsAndPresets;
+   bool mSpawnCatalogDirty{ true };
+   uint64_t mSpawnCatalogSourcesStamp{ 0 };
+   std::string mLastSpawnQuery;
+   bool mLastSpawnQueryContinuous{ false };
+   std::vector<int> mLastSpawnQueryMatches;
 };
 
 #endif /* defined(__modularSynth__ModuleFactory__) */
@@ -171,6 +171,13 @@ void MultitrackRecorder::ButtonClicked(ClickButton* button, double time)
    }
 }
 
+void MultitrackRecorder::StopRecording()
+{
+   mRecord = false;
+   for (auto* track : mTracks)
+      track->SetRecording(false);
+}
+
 void MultitrackRecorder::CheckboxUpdated(Checkbox* checkbox, double time)
 {
    if (checkbox == mRecordCheckbox)
@@ -267,17 +274,20 @@ void MultitrackRecorder::LoadState(FileStreamIn& in, int rev)
 
 namespace
 {
-   const int kRecordingChunkSize = 48000 * 5;
+   const int kRecordingChunkSeconds = 5;
    const int kMinRecordingChunks = 2;
 };
 
 MultitrackRecorderTrack::MultitrackRecorderTrack()
 : IAudioProcessor(gBufferSize)
+, mRecordingChunkSize(int(gSampleRate * kRecordingChunkSeconds))
 {
 }
 
 MultitrackRecorderTrack::~MultitrackRecorderTrack()
 {
+   for (int i = 0; i < mNumRecordChunks; ++i)
+      delete mRecordChunks[i];
 }
 
 void MultitrackRecorderTrack::CreateUIControls()
@@ -294,7 +304,8 @@ void MultitrackRecorderTrack::CreateUIControls()
 void MultitrackRecorderTrack::Process(double time)
 {
    int numChannels = GetBuffer()->NumActiveChannels();
-   for (size_t i = 0; i < mRecordChunks.size(); ++i)
+   int numChunks = mNumRecordChunks;
+   for (int i = 0; i < numChunks; ++i)
    {
       if (mRecordChunks[i]->NumActiveChannels() > numChannels)
          numChannels = mRecordChunks[i]->NumActiveChannels();
@@ -305,17 +316,36 @@ void MultitrackRecorderTrack::Process(double time)
 
    if (mDoRecording)
    {
-      for (size_t i = 0; i < mRecordChunks.size(); ++i)
+      for (int i = 0; i < numChunks; ++i)
          mRecordChunks[i]->SetNumActiveChannels(numChannels);
 
+      int recordStart = mRecordingLength;
       for (int i = 0; i < GetBuffer()->BufferSize(); ++i)
       {
-         int chunkIndex = mRecordingLength / kRecordingChunkSize;
-         int chunkPos = mRecordingLength % kRecordingChunkSize;
+         int chunkIndex = mRecordingLength / mRecordingChunkSize;
+         int chunkPos = mRecordingLength % mRecordingChunkSize;
+         if (chunkIndex >= numChunks) //Poll() hasn't caught up, or we're at the maximum length
+         {
+            if (numChunks == kMaxRecordingChunks)
+            {
+               mDoRecording = false;
+               mHitMaxLength = true;
+            }
+            break;
+         }
          for (int ch = 0; ch < numChannels; ++ch)
             mRecordChunks[chunkIndex]->GetChannel(ch)[chunkPos] = GetBuffer()->GetChannel(MIN(ch, GetBuffer()->NumActiveChannels() - 1))[i];
          ++mRecordingLength;
       }
+
+      //so the waveform display only rescans what was just recorded
+      for (int pos = recordStart; pos < mRecordingLength;)
+      {
+         int chunkPos = pos % mRecordingChunkSize;
+         int length = MIN(mRecordingLength - pos, mRecordingChunkSize - chunkPos);
+         mRecordChunks[pos / mRecordingChunkSize]->MarkWritten(chunkPos, length);
+         pos += length;
+      }
    }
 
    if (GetTarget())
@@ -335,11 +365,22 @@ void MultitrackRecorderTrack::Poll()
 {
    IDrawableModule::Poll();
 
-   int chunkIndex = mRecordingLength / kRecordingChunkSize;
-   if (chunkIndex >= (int)mRecordChunks.size() - 1)
+   if (mHitMaxLength.exchange(false))
+   {
+      TheSynth->LogEvent("multitrackrecorder: stopped recording at the maximum length of " + ofToString(kMaxRecordingChunks * kRecordingChunkSeconds / 60) + " minutes", kLogEventType_Warning);
+      if (mRecorder != nullptr)
+         mRecorder->StopRecording();
+   }
+
+   int numChunks = mNumRecordChunks;
+   int chunkIndex = mRecordingLength / mRecordingChunkSize;
+   if (chunkIndex >= numChunks - 1 && numChunks < kMaxRecordingChunks)
    {
-      mRecordChunks.push_back(new ChannelBuffer(kRecordingChunkSize));
-      mRecordChunks[mRecordChunks.size() - 1]->GetChannel(0); //set up buffer
+      ChannelBuffer* chunk = new ChannelBuffer(mRecordingChunkSize);
+      chunk->GetChannel(0); //set up buffer
+      chunk->EnablePeakPyramid();
+      mRecordChunks[numChunks] = chunk;
+      mNumRecordChunks = numChunks + 1; //publish only once the chunk is ready
    }
 }
 
@@ -366,12 +407,12 @@ void MultitrackRecorderTrack::DrawModule()
    }
 
    ofPushMatrix();
-   int numChunks = mRecordingLength / kRecordingChunkSize + 1;
+   int numChunks = mRecordingLength / mRecordingChunkSize + 1;
    float chunkWidth = sampleWidth / numChunks;
    for (int i = 0; i < numChunks; ++i)
    {
-      if (i < (int)mRecordChunks.size())
-         DrawAudioBuffer(chunkWidth, height - 6, mRecordChunks[i], 0, kRecordingChunkSize, -1);
+      if (i < mNumRecordChunks)
+         DrawAudioBuffer(chunkWidth, height - 6, mRecordChunks[i], 0, mRecordingChunkSize, -1);
       ofTranslate(chunkWidth, 0);
    }
    ofPopMatrix();
@@ -393,13 +434,15 @@ void MultitrackRecorderTrack::SetRecording(bool record)
       {
          mRecordingLength = 0;
 
-         for (size_t i = mRecordChunks.size(); i < kMinRecordingChunks; ++i)
+         for (int i = mNumRecordChunks; i < kMinRecordingChunks; ++i)
          {
-            mRecordChunks.push_back(new ChannelBuffer(kRecordingChunkSize));
+            mRecordChunks[i] = new ChannelBuffer(mRecordingChunkSize);
             mRecordChunks[i]->GetChannel(0); //set up buffer
+            mRecordChunks[i]->EnablePeakPyramid();
+            mNumRecordChunks = i + 1;
          }
 
-         for (size_t i = 0; i < mRecordChunks.size(); ++i)
+         for (int i = 0; i < mNumRecordChunks; ++i)
             mRecordChunks[i]->Clear();
       }
 
@@ -414,7 +457,7 @@ void MultitrackRecorderTrack::SetRecording(bool record)
 Sample* MultitrackRecorderTrack::BounceRecording()
 {
    Sample* sample = nullptr;
-   if (mRecordingLength > 0)
+   if (mRecordingLength > 0 && mNumRecordChunks > 0)
    {
       sample = new Sample();
       sample->Create(mRecordingLength);
@@ -422,17 +465,17 @@ Sample* MultitrackRecorderTrack::BounceRecording()
       int channelCount = mRecordChunks[0]->NumActiveChannels();
       data->SetNumActiveChannels(channelCount);
 
-      int numChunks = mRecordingLength / kRecordingChunkSize + 1;
+      int numChunks = MIN(mRecordingLength / mRecordingChunkSize + 1, (int)mNumRecordChunks);
       for (int i = 0; i < numChunks; ++i)
       {
-         int samplesLeftToRecord = mRecordingLength - i * kRecordingChunkSize;
+         int samplesLeftToRecord = mRecordingLength - i * mRecordingChunkSize;
          int samplesToCopy;
-         if (samplesLeftToRecord > kRecordingChunkSize)
-            samplesToCopy = kRecordingChunkSize;
+         if (samplesLeftToRecord > mRecordingChunkSize)
+            samplesToCopy = mRecordingChunkSize;
          else
             samplesToCopy = samplesLeftToRecord;
          for (int ch = 0; ch < channelCount; ++ch)
-            BufferCopy(data->GetChannel(ch) + i * kRecordingChunkSize, mRecordChunks[i]->GetChannel(ch), samplesToCopy);
+            BufferCopy(data->GetChannel(ch) + i * mRecordingChunkSize, mRecordChunks[i]->GetChannel(ch), samplesToCopy);
       }
    }
 
@@ -441,10 +484,18 @@ Sample* MultitrackRecorderTrack::BounceRecording()
 
 void MultitrackRecorderTrack::Clear()
 {
-   for (auto* recordChunk : mRecordChunks)
+   std::vector<ChannelBuffer*> chunksToDelete;
+   {
+      //detach the chunks from the audio thread, but free them outside of the lock
+      ScopedMutex mutex(TheSynth->GetAudioMutex(), "MultitrackRecorderTrack::Clear()");
+      chunksToDelete.assign(mRecordChunks.begin(), mRecordChunks.begin() + mNumRecordChunks);
+      mRecordChunks.fill(nullptr);
+      mNumRecordChunks = 0;
+      mRecordingLength = 0;
+   }
+
+   for (auto* recordChunk : chunksToDelete)
       delete recordChunk;
-   mRecordChunks.clear();
-   mRecordingLength = 0;
 }
 
 void MultitrackRecorderTrack::FloatSliderUpdated(FloatSlider* slider, float oldVal, double time)
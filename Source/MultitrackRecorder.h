@@ -26,6 +26,8 @@
 #pragma once
 
 #include <iostream>
+#include <array>
+#include <atomic>
 #include "IDrawableModule.h"
 #include "Slider.h"
 #include "ClickButton.h"
@@ -52,6 +54,7 @@ public:
    void Resize(float width, float height) override { mWidth = ofClamp(width, 210, 9999); }
 
    void RemoveTrack(MultitrackRecorderTrack* track);
+   void StopRecording();
 
    void ButtonClicked(ClickButton* button, double time) override;
    void CheckboxUpdated(Checkbox* checkbox, double time) override;
@@ -127,8 +130,13 @@ private:
 
    MultitrackRecorder* mRecorder{ nullptr };
 
-   std::vector<ChannelBuffer*> mRecordChunks;
+   //chunks are allocated ahead of the record head in Poll(), the array never reallocates so Process() can index it safely
+   static constexpr int kMaxRecordingChunks = 1440;
+   std::array<ChannelBuffer*, kMaxRecordingChunks> mRecordChunks{};
+   std::atomic<int> mNumRecordChunks{ 0 };
+   int mRecordingChunkSize{ 0 };
    bool mDoRecording{ false };
+   std::atomic<bool> mHitMaxLength{ false }; //set by Process() when the last chunk fills up, handled in Poll()
    int mRecordingLength{ 0 };
    ClickButton* mDeleteButton{ nullptr };
 };
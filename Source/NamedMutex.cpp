@@ -24,6 +24,7 @@
 //
 
 #include "NamedMutex.h"
+#include "RealtimeSafetyMonitor.h"
 
 void NamedMutex::Lock(std::string locker)
 {
@@ -32,6 +33,7 @@ void NamedMutex::Lock(std::string locker)
       ++mExtraLockCount;
       return;
    }
+   RealtimeSafetyMonitor::OnMutexLock(locker.c_str());
    mMutex.lock();
    mLocker = locker;
 }
@@ -122,6 +122,29 @@ void NoteChance::PlayNote(double time, int pitch, int velocity, int voiceIdx, Mo
       return;
    }
 
+   if (ShouldPlay(time, velocity))
+      PlayNoteOutput(time, pitch, velocity, voiceIdx, modulation);
+}
+
+void NoteChance::PlayNotes(const NoteEvent* notes, int count)
+{
+   if (!mEnabled)
+   {
+      PlayNotesOutput(notes, count);
+      return;
+   }
+
+   NoteBatch batch;
+   for (int i = 0; i < count; ++i)
+   {
+      if (ShouldPlay(notes[i].time, notes[i].velocity))
+         AddToNoteBatch(batch, notes[i]);
+   }
+   PlayNotesOutput(batch);
+}
+
+bool NoteChance::ShouldPlay(double time, int velocity)
+{
    if (velocity > 0)
       ComputeSliders(0);
 
@@ -139,8 +162,6 @@ void NoteChance::PlayNote(double time, int pitch, int velocity, int voiceIdx, Mo
    }
 
    bool accept = random <= mChance;
-   if (accept || velocity == 0)
-      PlayNoteOutput(time, pitch, velocity, voiceIdx, modulation);
 
    if (velocity > 0)
    {
@@ -149,6 +170,8 @@ void NoteChance::PlayNote(double time, int pitch, int velocity, int voiceIdx, Mo
       else
          mLastRejectTime = time;
    }
+
+   return accept || velocity == 0;
 }
 
 void NoteChance::Reseed()
@@ -47,6 +47,7 @@ public:
 
    //INoteReceiver
    void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) override;
+   void PlayNotes(const NoteEvent* notes, int count) override;
 
    void FloatSliderUpdated(FloatSlider* slider, float oldVal, double time) override {}
    void IntSliderUpdated(IntSlider* slider, int oldVal, double time) override {}
@@ -64,6 +65,7 @@ private:
    void GetModuleDimensions(float& width, float& height) override;
 
    void Reseed();
+   bool ShouldPlay(double time, int velocity);
 
    float mChance{ 1 };
    FloatSlider* mChanceSlider{ nullptr };
@@ -66,6 +66,36 @@ void NoteOctaver::PlayNote(double time, int pitch, int velocity, int voiceIdx, M
       return;
    }
 
+   UpdateInputNote(pitch, velocity, voiceIdx);
+
+   PlayNoteOutput(time, mInputNotes[pitch].mOutputPitch, velocity, mInputNotes[pitch].mVoiceIdx, modulation);
+}
+
+void NoteOctaver::PlayNotes(const NoteEvent* notes, int count)
+{
+   if (!mEnabled)
+   {
+      PlayNotesOutput(notes, count);
+      return;
+   }
+
+   NoteBatch batch;
+   for (int i = 0; i < count; ++i)
+   {
+      NoteEvent note = notes[i];
+      if (note.pitch >= 0 && note.pitch < 128)
+      {
+         UpdateInputNote(note.pitch, note.velocity, note.voiceIdx);
+         note.pitch = mInputNotes[notes[i].pitch].mOutputPitch;
+         note.voiceIdx = mInputNotes[notes[i].pitch].mVoiceIdx;
+      }
+      AddToNoteBatch(batch, note);
+   }
+   PlayNotesOutput(batch);
+}
+
+void NoteOctaver::UpdateInputNote(int pitch, int velocity, int voiceIdx)
+{
    if (pitch >= 0 && pitch < 128)
    {
       if (velocity > 0)
@@ -80,8 +110,6 @@ void NoteOctaver::PlayNote(double time, int pitch, int velocity, int voiceIdx, M
          mInputNotes[pitch].mOn = false;
       }
    }
-
-   PlayNoteOutput(time, mInputNotes[pitch].mOutputPitch, velocity, mInputNotes[pitch].mVoiceIdx, modulation);
 }
 
 void NoteOctaver::IntSliderUpdated(IntSlider* slider, int oldVal, double time)
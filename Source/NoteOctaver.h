@@ -48,6 +48,7 @@ public:
 
    //INoteReceiver
    void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) override;
+   void PlayNotes(const NoteEvent* notes, int count) override;
 
    void CheckboxUpdated(Checkbox* checkbox, double time) override;
    //IIntSliderListener
@@ -75,6 +76,8 @@ private:
       height = mHeight;
    }
 
+   void UpdateInputNote(int pitch, int velocity, int voiceIdx);
+
    float mWidth{ 200 };
    float mHeight{ 20 };
    int mOctave{ 0 };
@@ -25,48 +25,105 @@
 
 #include "NoteOutputQueue.h"
 #include "INoteSource.h"
+#include "IPulseReceiver.h"
 #include "ModularSynth.h"
 
+NoteOutputQueue::NoteOutputQueue()
+{
+}
+
+void NoteOutputQueue::Enqueue(const PendingEvent& event)
+{
+   if (!mQueue.TryEnqueue(event))
+      mDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+}
+
 void NoteOutputQueue::QueuePlayNote(NoteOutput* target, double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation)
 {
-   PendingNoteOutput output;
-   output.target = target;
-   output.time = time;
-   output.pitch = pitch;
-   output.velocity = velocity;
-   output.voiceIdx = voiceIdx;
-   output.modulation = modulation;
-   mQueue.enqueue(output);
+   PendingEvent event;
+   event.type = EventType::kPlayNote;
+   event.target = target;
+   event.time = time;
+   event.pitch = pitch;
+   event.velocity = velocity;
+   event.voiceIdx = voiceIdx;
+   event.modulation = modulation;
+   Enqueue(event);
 }
 
 void NoteOutputQueue::QueueFlush(NoteOutput* target, double time)
 {
-   PendingNoteOutput output;
-   output.target = target;
-   output.isFlush = true;
-   output.time = time;
-   mQueue.enqueue(output);
+   PendingEvent event;
+   event.type = EventType::kFlush;
+   event.target = target;
+   event.time = time;
+   Enqueue(event);
+}
+
+void NoteOutputQueue::QueuePulse(IPulseSource* source, PatchCableSource* destination, double time, float velocity, int flags)
+{
+   PendingEvent event;
+   event.type = EventType::kPulse;
+   event.pulseSource = source;
+   event.pulseDestination = destination;
+   event.time = time;
+   event.pulseVelocity = velocity;
+   event.pulseFlags = flags;
+   Enqueue(event);
 }
 
 void NoteOutputQueue::Process()
 {
    assert(IsAudioThread());
 
-   PendingNoteOutput output;
-   while (true)
-   {
-      bool hasData = mQueue.try_dequeue(output);
-      if (!hasData)
-         break;
+   //consecutive notes for the same output are sent on together
+   NoteBatch batch;
+   NoteOutput* batchTarget = nullptr;
 
-      if (output.isFlush)
+   PendingEvent event;
+   while (mQueue.TryDequeue(event))
+   {
+      if (batchTarget != nullptr && (event.type != EventType::kPlayNote || event.target != batchTarget || batch.IsFull()))
       {
-         output.target->Flush(output.time);
+         batchTarget->PlayNotesInternal(batch.GetNotes(), batch.GetCount());
+         batch.Clear();
+         batchTarget = nullptr;
       }
-      else
+
+      switch (event.type)
       {
-         //ofLog() << "playing queued note " << output.time << " " << output.pitch << " " << output.velocity << " " << gTime;
-         output.target->PlayNoteInternal(output.time, output.pitch, output.velocity, output.voiceIdx, output.modulation, false);
+         case EventType::kPlayNote:
+         {
+            //ofLog() << "playing queued note " << event.time << " " << event.pitch << " " << event.velocity << " " << gTime;
+            NoteEvent note;
+            note.time = event.time;
+            note.pitch = event.pitch;
+            note.velocity = event.velocity;
+            note.voiceIdx = event.voiceIdx;
+            note.modulation = event.modulation;
+            batch.Add(note);
+            batchTarget = event.target;
+            break;
+         }
+         case EventType::kFlush:
+            event.target->Flush(event.time);
+            break;
+         case EventType::kPulse:
+            event.pulseSource->DispatchPulse(event.pulseDestination, event.time, event.pulseVelocity, event.pulseFlags);
+            break;
       }
    }
+
+   if (batchTarget != nullptr)
+      batchTarget->PlayNotesInternal(batch.GetNotes(), batch.GetCount());
+}
+
+void NoteOutputQueue::ReportDroppedEvents()
+{
+   int dropped = mDroppedEvents.load(std::memory_order_relaxed);
+   if (dropped != mReportedDroppedEvents)
+   {
+      TheSynth->LogEvent("event queue full, dropped " + ofToString(dropped - mReportedDroppedEvents) + " notes/pulses sent from outside the audio thread", kLogEventType_Error);
+      mReportedDroppedEvents = dropped;
+   }
 }
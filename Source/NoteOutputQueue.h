@@ -25,29 +25,53 @@
 
 #pragma once
 
-#include "readerwriterqueue.h"
+#include "BoundedMPSCQueue.h"
 #include "ModulationChain.h"
 
 class NoteOutput;
+class IPulseSource;
+class PatchCableSource;
 
+//events sent from the UI, midi, osc and script threads, delivered at the start of the next audio buffer
 class NoteOutputQueue
 {
 public:
+   NoteOutputQueue();
+
    void QueuePlayNote(NoteOutput* target, double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation);
    void QueueFlush(NoteOutput* target, double time);
+   void QueuePulse(IPulseSource* source, PatchCableSource* destination, double time, float velocity, int flags);
    void Process();
+   void ReportDroppedEvents();
+
+   static constexpr int kCapacity = 4096;
 
 private:
-   struct PendingNoteOutput
+   enum class EventType
+   {
+      kPlayNote,
+      kFlush,
+      kPulse
+   };
+
+   struct PendingEvent
    {
-      NoteOutput* target;
-      bool isFlush{ false };
+      EventType type{ EventType::kPlayNote };
+      NoteOutput* target{ nullptr };
+      IPulseSource* pulseSource{ nullptr };
+      PatchCableSource* pulseDestination{ nullptr };
       double time{ 0 };
       int pitch{ 0 };
       int velocity{ 0 };
       int voiceIdx{ -1 };
+      float pulseVelocity{ 0 };
+      int pulseFlags{ 0 };
       ModulationParameters modulation{};
    };
 
-   moodycamel::ReaderWriterQueue<PendingNoteOutput> mQueue;
+   void Enqueue(const PendingEvent& event);
+
+   BoundedMPSCQueue<PendingEvent> mQueue{ kCapacity };
+   std::atomic<int> mDroppedEvents{ 0 };
+   int mReportedDroppedEvents{ 0 };
 };
@@ -27,6 +27,16 @@
 #include "SynthGlobals.h"
 #include "IPulseReceiver.h"
 #include "TitleBar.h"
+#include "Transport.h"
+#include "ModularSynth.h"
+#include "Slider.h"
+
+namespace
+{
+   const std::string kControlPrefix = "/bespoke/control/";
+   const std::string kControlScaledPrefix = "/bespoke/control_scaled/";
+   const double kMaxScheduleAheadMs = 10000;
+}
 
 OscController::OscController(MidiDeviceListener* listener, std::string outAddress, int outPort, int inPort)
 : mListener(listener)
@@ -35,11 +45,16 @@ OscController::OscController(MidiDeviceListener* listener, std::string outAddres
 , mInPort(inPort)
 {
    Connect();
+   TheTransport->AddAudioPoller(this);
 }
 
 OscController::~OscController()
 {
    OSCReceiver::disconnect();
+   cancelPendingUpdate();
+
+   ScopedMutex mutex(TheSynth->GetAudioMutex(), "~OscController()");
+   TheTransport->RemoveAudioPoller(this);
 }
 
 void OscController::Connect()
@@ -115,7 +130,164 @@ void OscController::SendValue(int page, int control, float value, bool forceNote
    }
 }
 
+//called on the OSC receiver thread
 void OscController::oscMessageReceived(const juce::OSCMessage& msg)
+{
+   if (!QueueControlEvent(msg, juce::OSCTimeTag::immediately))
+      ForwardToMessageThread(msg);
+}
+
+//called on the OSC receiver thread
+void OscController::oscBundleReceived(const juce::OSCBundle& bundle)
+{
+   for (const auto& element : bundle)
+   {
+      if (element.isMessage())
+      {
+         if (!QueueControlEvent(element.getMessage(), bundle.getTimeTag()))
+            ForwardToMessageThread(element.getMessage());
+      }
+      else if (element.isBundle())
+      {
+         oscBundleReceived(element.getBundle());
+      }
+   }
+}
+
+//numeric values for sliders that have been resolved before skip the message thread, and go to the audio thread to be applied at their timetag
+bool OscController::QueueControlEvent(const juce::OSCMessage& msg, juce::OSCTimeTag timeTag)
+{
+   if (msg.size() == 0 || (!msg[0].isFloat32() && !msg[0].isInt32()))
+      return false;
+
+   ControlEvent event;
+   std::string address = msg.getAddressPattern().toString().toStdString();
+   std::string path;
+   if (address.rfind(kControlPrefix, 0) == 0)
+   {
+      path = address.substr(kControlPrefix.length());
+   }
+   else if (address.rfind(kControlScaledPrefix, 0) == 0)
+   {
+      event.mScaled = true;
+      path = address.substr(kControlScaledPrefix.length());
+   }
+   else
+   {
+      return false;
+   }
+
+   path = juce::URL::removeEscapeChars(path).toStdString();
+   if (path.length() >= ControlEvent::kMaxPathLength)
+      return false;
+
+   event.mPathGeneration = IClickable::GetPathGeneration();
+   event.mControl = TheSynth->FindCachedUIControl(path);
+   if (dynamic_cast<FloatSlider*>(event.mControl) == nullptr)
+      return false; //unresolved paths go through the message thread, which caches them for next time. other control types can do heavy work when set.
+
+   StringCopy(event.mPath, path.c_str(), ControlEvent::kMaxPathLength);
+   event.mValue = msg[0].isFloat32() ? msg[0].getFloat32() : msg[0].getInt32();
+   if (!timeTag.isImmediately())
+   {
+      double delayMs = double(timeTag.toTime().toMilliseconds() - juce::Time::currentTimeMillis());
+      if (delayMs > 0)
+         event.mTime = gTime + MIN(delayMs, kMaxScheduleAheadMs);
+   }
+
+   return mControlQueue.TryEnqueue(event);
+}
+
+void OscController::ForwardToMessageThread(const juce::OSCMessage& msg)
+{
+   {
+      std::lock_guard<std::mutex> lock(mForwardedMessagesMutex);
+      mForwardedMessages.push_back(msg);
+   }
+   triggerAsyncUpdate();
+}
+
+void OscController::handleAsyncUpdate()
+{
+   std::deque<juce::OSCMessage> messages;
+   {
+      std::lock_guard<std::mutex> lock(mForwardedMessagesMutex);
+      messages.swap(mForwardedMessages);
+   }
+
+   for (const auto& msg : messages)
+      HandleMessage(msg);
+}
+
+void OscController::OnTransportAdvanced(float amount)
+{
+   ControlEvent event;
+   while (mNumPendingControlEvents < kMaxPendingControlEvents && mControlQueue.TryDequeue(event))
+      mPendingControlEvents[mNumPendingControlEvents++] = event;
+
+   //apply everything that's due in this buffer, and keep the rest for later.
+   //untimed values that are followed by another untimed value for the same control in this buffer are skipped, since they'd be overwritten straight away.
+   double bufferEnd = gTime + gBufferSizeMs;
+   int numKept = 0;
+   for (int i = 0; i < mNumPendingControlEvents; ++i)
+   {
+      const ControlEvent& pending = mPendingControlEvents[i];
+      if (pending.mTime >= bufferEnd)
+      {
+         if (numKept != i)
+            mPendingControlEvents[numKept] = pending;
+         ++numKept;
+         continue;
+      }
+
+      bool superseded = false;
+      if (pending.mTime == 0)
+      {
+         for (int j = i + 1; j < mNumPendingControlEvents; ++j)
+         {
+            if (mPendingControlEvents[j].mTime == 0 && mPendingControlEvents[j].mControl == pending.mControl)
+            {
+               superseded = true;
+               break;
+            }
+         }
+      }
+
+      if (!superseded)
+         ApplyControlEvent(pending);
+   }
+   mNumPendingControlEvents = numKept;
+}
+
+void OscController::ApplyControlEvent(const ControlEvent& event)
+{
+   if (event.mPathGeneration != IClickable::GetPathGeneration())
+   {
+      //modules or controls changed since this was resolved. resolving takes the path cache lock (and can walk every module), so leave that to the main thread.
+      mStaleControlQueue.TryEnqueue(event);
+      return;
+   }
+
+   double time = MAX(event.mTime, gTime);
+   if (event.mScaled)
+      event.mControl->SetFromMidiCC(event.mValue, time, false);
+   else
+      event.mControl->SetValue(event.mValue, time);
+}
+
+void OscController::Poll()
+{
+   ControlEvent event;
+   while (mStaleControlQueue.TryDequeue(event))
+   {
+      event.mPathGeneration = IClickable::GetPathGeneration();
+      event.mControl = TheSynth->FindUIControl(event.mPath);
+      if (dynamic_cast<FloatSlider*>(event.mControl) != nullptr)
+         mControlQueue.TryEnqueue(event);
+   }
+}
+
+void OscController::HandleMessage(const juce::OSCMessage& msg)
 {
    std::string address = msg.getAddressPattern().toString().toStdString();
 
@@ -143,19 +315,17 @@ void OscController::oscMessageReceived(const juce::OSCMessage& msg)
    }
 
    bool is_percentage = false;
-   std::string control_prefix = "/bespoke/control/";
-   std::string control_scaled_prefix = "/bespoke/control_scaled/";
-   if (address.rfind(control_prefix, 0) == 0 || address.rfind(control_scaled_prefix, 0) == 0)
+   if (address.rfind(kControlPrefix, 0) == 0 || address.rfind(kControlScaledPrefix, 0) == 0)
    {
       std::string control_path;
-      if (address.rfind(control_prefix, 0) == 0)
+      if (address.rfind(kControlPrefix, 0) == 0)
       {
-         control_path = address.substr(control_prefix.length());
+         control_path = address.substr(kControlPrefix.length());
       }
-      else if (address.rfind(control_scaled_prefix, 0) == 0)
+      else if (address.rfind(kControlScaledPrefix, 0) == 0)
       {
          is_percentage = true;
-         control_path = address.substr(control_scaled_prefix.length());
+         control_path = address.substr(kControlScaledPrefix.length());
       }
       control_path = juce::URL::removeEscapeChars(control_path).toStdString();
 
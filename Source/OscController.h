@@ -30,6 +30,12 @@
 #include "MidiDevice.h"
 #include "INonstandardController.h"
 #include "ofxJSONElement.h"
+#include "IAudioPoller.h"
+#include "BoundedMPSCQueue.h"
+
+#include <array>
+#include <deque>
+#include <mutex>
 
 #include "juce_osc/juce_osc.h"
 
@@ -43,9 +49,15 @@ struct OscMap
    double mLastChangedTime{ -9999 }; //@TODO(Noxy): Unused but is in savestates.
 };
 
+class IUIControl;
+
+//messages are received on the OSC receiver's own thread. numeric /bespoke/control values for controls that have already been resolved are
+//queued straight to the audio thread and applied at their bundle timetag, everything else is handed to the message thread.
 class OscController : public INonstandardController,
+                      public IAudioPoller,
                       private juce::OSCReceiver,
-                      private juce::OSCReceiver::Listener<juce::OSCReceiver::MessageLoopCallback>
+                      private juce::OSCReceiver::Listener<juce::OSCReceiver::RealtimeCallback>,
+                      private juce::AsyncUpdater
 {
 public:
    OscController(MidiDeviceListener* listener, std::string outAddress, int outPort, int inPort);
@@ -53,6 +65,7 @@ public:
 
    void Connect();
    void oscMessageReceived(const juce::OSCMessage& msg) override;
+   void oscBundleReceived(const juce::OSCBundle& bundle) override;
    void SendValue(int page, int control, float value, bool forceNoteOn = false, int channel = -1) override;
    int AddControl(std::string address, bool isFloat);
 
@@ -63,14 +76,48 @@ public:
       return mConnected;
    }
    bool SetInPort(int port);
+   void Poll() override;
    std::string GetControlTooltip(MidiMessageType type, int control) override;
 
    void SaveState(FileStreamOut& out) override;
    void LoadState(FileStreamIn& in) override;
 
+   //IAudioPoller
+   void OnTransportAdvanced(float amount) override;
+
 private:
+   struct ControlEvent
+   {
+      static const int kMaxPathLength = 256;
+
+      IUIControl* mControl{ nullptr };
+      int mPathGeneration{ 0 };
+      char mPath[kMaxPathLength]{};
+      float mValue{ 0 };
+      bool mScaled{ false };
+      double mTime{ 0 }; //0 means as soon as possible
+   };
+
+   //juce::AsyncUpdater
+   void handleAsyncUpdate() override;
+
+   void HandleMessage(const juce::OSCMessage& msg);
+   bool QueueControlEvent(const juce::OSCMessage& msg, juce::OSCTimeTag timeTag);
+   void ForwardToMessageThread(const juce::OSCMessage& msg);
+   void ApplyControlEvent(const ControlEvent& event);
+
    MidiDeviceListener* mListener{ nullptr };
 
+   static const int kControlQueueSize = 1024;
+   static const int kMaxPendingControlEvents = 256;
+   BoundedMPSCQueue<ControlEvent> mControlQueue{ kControlQueueSize };
+   std::array<ControlEvent, kMaxPendingControlEvents> mPendingControlEvents; //audio thread only, waiting for their timetag
+   int mNumPendingControlEvents{ 0 };
+   BoundedMPSCQueue<ControlEvent> mStaleControlQueue{ kControlQueueSize }; //events whose path went stale before they were applied, re-resolved on the main thread
+
+   std::mutex mForwardedMessagesMutex;
+   std::deque<juce::OSCMessage> mForwardedMessages;
+
    int FindControl(std::string address);
    void ConnectOutput();
 
@@ -67,6 +67,10 @@ void PatchCable::Render()
    PatchCablePos cable = GetPatchCablePos();
    mX = cable.start.x;
    mY = cable.start.y;
+
+   if (IsOffscreen(cable))
+      return;
+
    ofVec2f cableFadeOut = cable.start * .47 + cable.end * .53f;
    ofVec2f cableFadeIn = cable.start * .53f + cable.end * .47f;
    float cableQuality = gDrawScale * UserPrefs.cable_quality.Get();
@@ -108,6 +112,7 @@ void PatchCable::Render()
             if (vizBuff == nullptr)
                vizBuff = audioSource->GetVizBuffer();
             assert(vizBuff);
+            vizBuff->RequestCapture(RollingBuffer::CaptureDemand::kCoarse);
             int numSamples = vizBuff->Size();
             bool allZero = true;
             for (int ch = 0; ch < vizBuff->NumChannels(); ++ch)
@@ -320,6 +325,7 @@ void PatchCable::Render()
          if (vizBuff == nullptr)
             vizBuff = audioSource->GetVizBuffer();
          assert(vizBuff);
+         vizBuff->RequestCapture(RollingBuffer::CaptureDemand::kCoarse);
          int numSamples = vizBuff->Size();
          float dx = (cable.plug.x - cable.start.x) / wireLength;
          float dy = (cable.plug.y - cable.start.y) / wireLength;
@@ -441,6 +447,26 @@ void PatchCable::Render()
    ofPopMatrix();
 }
 
+bool PatchCable::IsOffscreen(const PatchCablePos& cable) const
+{
+   //only cables on the main canvas share coordinates with the synth's draw rect
+   IDrawableModule* owningModule = dynamic_cast<IDrawableModule*>(mOwner->GetOwner()->GetRootParent());
+   if (owningModule == nullptr || owningModule->GetOwningContainer() != TheSynth->GetRootContainer())
+      return false;
+   if (mDragging || sActivePatchCable == this)
+      return false;
+
+   //the bezier control points sit at most 15% of the wire length away from the endpoints, so this box always contains the curve
+   float wireLength = sqrtf((cable.plug - cable.start).lengthSquared());
+   float margin = wireLength * .15f + 10;
+   float minX = MIN(cable.start.x, MIN(cable.plug.x, cable.end.x)) - margin;
+   float minY = MIN(cable.start.y, MIN(cable.plug.y, cable.end.y)) - margin;
+   float maxX = MAX(cable.start.x, MAX(cable.plug.x, cable.end.x)) + margin;
+   float maxY = MAX(cable.start.y, MAX(cable.plug.y, cable.end.y)) + margin;
+
+   return !TheSynth->GetDrawRect().intersects(ofRectangle(minX, minY, maxX - minX, maxY - minY));
+}
+
 bool PatchCable::MouseMoved(float x, float y)
 {
    x = TheSynth->GetMouseX(GetOwningModule()->GetOwningContainer());
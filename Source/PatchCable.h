@@ -104,6 +104,7 @@ protected:
 private:
    void SetCableTarget(IClickable* target);
    PatchCablePos GetPatchCablePos();
+   bool IsOffscreen(const PatchCablePos& cable) const;
    ofVec2f FindClosestSide(float x, float y, float w, float h, ofVec2f start, ofVec2f startDirection, ofVec2f& endDirection);
 
    PatchCableSource* mOwner{ nullptr };
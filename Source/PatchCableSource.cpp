@@ -32,6 +32,7 @@
 #include "IPulseReceiver.h"
 #include "AudioSend.h"
 #include "MacroSlider.h"
+#include "RollingBuffer.h"
 
 #include "juce_gui_basics/juce_gui_basics.h"
 
@@ -99,6 +100,13 @@ PatchCable* PatchCableSource::AddPatchCable(IClickable* target)
    return cable;
 }
 
+void PatchCableSource::SetOverrideVizBuffer(RollingBuffer* viz)
+{
+   mOverrideVizBuffer = viz;
+   if (viz != nullptr)
+      viz->SetDemandDriven(true); //only ever read to draw the cable
+}
+
 void PatchCableSource::SetPatchCableTarget(PatchCable* cable, IClickable* target, bool fromUserClick)
 {
    IClickable* oldTarget = cable->GetTarget();
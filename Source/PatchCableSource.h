@@ -95,7 +95,7 @@ public:
    ConnectionType GetConnectionType() const { return mType; }
    void SetConnectionType(ConnectionType type);
    IDrawableModule* GetOwner() const { return mOwner; }
-   void SetOverrideVizBuffer(RollingBuffer* viz) { mOverrideVizBuffer = viz; }
+   void SetOverrideVizBuffer(RollingBuffer* viz);
    RollingBuffer* GetOverrideVizBuffer() const { return mOverrideVizBuffer; }
    void UpdatePosition(bool parentMinimized);
    void SetManualPosition(int x, int y)
@@ -0,0 +1,150 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    PeakPyramid.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PeakPyramid.h"
+#include "SynthGlobals.h"
+
+void PeakPyramid::MarkWritten(int start, int length)
+{
+   if (length <= 0)
+      return;
+
+   int end = start + length;
+   int dirtyStart = mDirtyStart.load(std::memory_order_relaxed);
+   while (start < dirtyStart && !mDirtyStart.compare_exchange_weak(dirtyStart, start))
+   {
+   }
+   int dirtyEnd = mDirtyEnd.load(std::memory_order_relaxed);
+   while (end > dirtyEnd && !mDirtyEnd.compare_exchange_weak(dirtyEnd, end))
+   {
+   }
+}
+
+void PeakPyramid::Update(const float* data, int bufferSize)
+{
+   bool rebuild = mNeedsRebuild.exchange(false);
+   if (rebuild || data != mData || bufferSize != mBufferSize)
+   {
+      mData = data;
+      mBufferSize = bufferSize;
+      mDirtyStart = std::numeric_limits<int>::max();
+      mDirtyEnd = -1;
+
+      mLevels.clear();
+      int numBuckets = (bufferSize + kBaseBucketSize - 1) / kBaseBucketSize;
+      while (numBuckets > 0)
+      {
+         mLevels.emplace_back(numBuckets);
+         if (numBuckets == 1)
+            break;
+         numBuckets = (numBuckets + 1) / 2;
+      }
+
+      if (!mLevels.empty() && mData != nullptr)
+         UpdateBuckets(0, (int)mLevels[0].size() - 1);
+      return;
+   }
+
+   int dirtyStart = mDirtyStart.exchange(std::numeric_limits<int>::max());
+   int dirtyEnd = mDirtyEnd.exchange(-1);
+   if (dirtyEnd > dirtyStart && !mLevels.empty() && mData != nullptr)
+   {
+      int lastBucket = (int)mLevels[0].size() - 1;
+      int firstBucket = MAX(0, MIN(dirtyStart / kBaseBucketSize, lastBucket));
+      UpdateBuckets(firstBucket, MAX(firstBucket, MIN((dirtyEnd - 1) / kBaseBucketSize, lastBucket)));
+   }
+}
+
+void PeakPyramid::UpdateBuckets(int firstBucket, int lastBucket)
+{
+   std::vector<Peak>& base = mLevels[0];
+   for (int bucket = firstBucket; bucket <= lastBucket; ++bucket)
+   {
+      int start = bucket * kBaseBucketSize;
+      int end = MIN(start + kBaseBucketSize, mBufferSize);
+      Peak peak;
+      peak.mMin = mData[start];
+      peak.mMax = mData[start];
+      float sumSquares = 0;
+      for (int i = start; i < end; ++i)
+      {
+         float sample = mData[i];
+         peak.mMin = MIN(peak.mMin, sample);
+         peak.mMax = MAX(peak.mMax, sample);
+         sumSquares += sample * sample;
+      }
+      peak.mMeanSquare = sumSquares / (end - start);
+      base[bucket] = peak;
+   }
+
+   for (size_t level = 1; level < mLevels.size(); ++level)
+   {
+      firstBucket /= 2;
+      lastBucket /= 2;
+      const std::vector<Peak>& below = mLevels[level - 1];
+      std::vector<Peak>& current = mLevels[level];
+      for (int bucket = firstBucket; bucket <= lastBucket; ++bucket)
+      {
+         Peak peak = below[bucket * 2];
+         if (bucket * 2 + 1 < (int)below.size())
+         {
+            const Peak& other = below[bucket * 2 + 1];
+            peak.mMin = MIN(peak.mMin, other.mMin);
+            peak.mMax = MAX(peak.mMax, other.mMax);
+            peak.mMeanSquare = (peak.mMeanSquare + other.mMeanSquare) * .5f;
+         }
+         current[bucket] = peak;
+      }
+   }
+}
+
+PeakPyramid::Peak PeakPyramid::GetPeak(int start, int end) const
+{
+   Peak peak;
+   start = MAX(start, 0);
+   end = MIN(end, mBufferSize);
+   if (end <= start || mLevels.empty())
+      return peak;
+
+   //use the coarsest level that still has a few entries across the range
+   int level = 0;
+   while (level + 1 < (int)mLevels.size() && (kBaseBucketSize << (level + 1)) * 4 <= end - start)
+      ++level;
+
+   int bucketSize = kBaseBucketSize << level;
+   const std::vector<Peak>& entries = mLevels[level];
+   int firstBucket = start / bucketSize;
+   int lastBucket = MIN((end - 1) / bucketSize, (int)entries.size() - 1);
+   peak = entries[firstBucket];
+   for (int bucket = firstBucket + 1; bucket <= lastBucket; ++bucket)
+   {
+      peak.mMin = MIN(peak.mMin, entries[bucket].mMin);
+      peak.mMax = MAX(peak.mMax, entries[bucket].mMax);
+      peak.mMeanSquare += entries[bucket].mMeanSquare;
+   }
+   peak.mMeanSquare /= lastBucket - firstBucket + 1;
+   return peak;
+}
@@ -0,0 +1,65 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    PeakPyramid.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <vector>
+
+//min/max/rms summaries of a channel at halving resolutions, so a waveform can be drawn at any zoom level by touching a handful of entries per pixel.
+//it is built lazily on the drawing thread, and writers report the ranges they changed with MarkWritten() so only those get rescanned.
+class PeakPyramid
+{
+public:
+   struct Peak
+   {
+      float mMin{ 0 };
+      float mMax{ 0 };
+      float mMeanSquare{ 0 };
+
+      float GetMagnitude() const { return mMax > -mMin ? mMax : -mMin; }
+   };
+
+   static const int kBaseBucketSize = 64;
+
+   void Invalidate() { mNeedsRebuild = true; }
+   void MarkWritten(int start, int length); //safe to call from any thread
+
+   //call before GetPeak(), from the thread that draws
+   void Update(const float* data, int bufferSize);
+   Peak GetPeak(int start, int end) const;
+
+private:
+   void UpdateBuckets(int firstBucket, int lastBucket);
+
+   const float* mData{ nullptr };
+   int mBufferSize{ 0 };
+   std::vector<std::vector<Peak>> mLevels; //level 0 covers kBaseBucketSize samples per entry, each level above covers twice as many
+   std::atomic<bool> mNeedsRebuild{ true };
+   std::atomic<int> mDirtyStart{ std::numeric_limits<int>::max() };
+   std::atomic<int> mDirtyEnd{ -1 };
+};
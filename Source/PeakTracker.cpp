@@ -27,14 +27,14 @@
 #include "SynthGlobals.h"
 #include "Profiler.h"
 
-void PeakTracker::Process(float* buffer, int bufferSize)
+void PeakTracker::Process(const float* buffer, int bufferSize, int stride /*= 1*/)
 {
    PROFILER(PeakTracker);
 
+   const float scalar = powf(0.5f, 1.0f / (mDecayTime * gSampleRate));
    for (int j = 0; j < bufferSize; ++j)
    {
-      float scalar = powf(0.5f, 1.0f / (mDecayTime * gSampleRate));
-      float input = fabsf(buffer[j]);
+      float input = fabsf(buffer[j * stride]);
 
       if (input >= mPeak)
       {
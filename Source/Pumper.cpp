@@ -84,6 +84,7 @@ void Pumper::ProcessAudio(double time, ChannelBuffer* buffer)
    ComputeSliders(0);
 
    double intervalPos = GetIntervalPos(time);
+   double intervalsPerSample = gInvSampleRateMs / TheTransport->GetDuration(mInterval);
 
    ADSR::EventInfo adsrEvent(0, kAdsrTime);
    adsrEvent.mStartBlendFromValue = 1;
@@ -94,7 +95,7 @@ void Pumper::ProcessAudio(double time, ChannelBuffer* buffer)
 
    for (int i = 0; i < bufferSize; ++i)
    {
-      float adsrValue = mAdsr.Value((intervalPos + i * gInvSampleRateMs / TheTransport->GetDuration(mInterval)) * kAdsrTime, &adsrEvent);
+      float adsrValue = mAdsr.Value((intervalPos + i * intervalsPerSample) * kAdsrTime, &adsrEvent);
       float value = mLastValue * .99f + adsrValue * .01f;
       for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
          buffer->GetChannel(ch)[i] *= value;
@@ -79,6 +79,7 @@ void QuickSpawnFollower::SetUp()
 void QuickSpawnMenu::ShowSpawnCategoriesPopup()
 {
    ResetAppearPos();
+   TheSynth->GetModuleFactory()->UpdateSpawnCatalog();
    mMenuMode = MenuMode::ModuleCategories;
    mSearchString = "";
    mFilterForCable = nullptr;
@@ -88,6 +89,7 @@ void QuickSpawnMenu::ShowSpawnCategoriesPopup()
 void QuickSpawnMenu::ShowSpawnCategoriesPopupForCable(PatchCable* cable)
 {
    ResetAppearPos();
+   TheSynth->GetModuleFactory()->UpdateSpawnCatalog();
    mMenuMode = MenuMode::ModuleCategories;
    mSearchString = "";
    mFilterForCable = cable;
@@ -120,6 +122,8 @@ void QuickSpawnMenu::KeyPressed(int key, bool isRepeat)
 
    if ((!IsShowing() || mMenuMode == MenuMode::SingleLetter) && key >= 0 && key < CHAR_MAX && ((key >= 'a' && key <= 'z') || key == ';') && !isRepeat && GetKeyModifiers() == kModifier_None)
    {
+      if (!IsShowing())
+         TheSynth->GetModuleFactory()->UpdateSpawnCatalog(); //pick up new presets, prefabs and devices when the menu opens
       mHeldKeys += (char)key;
       mMenuMode = MenuMode::SingleLetter;
       mFilterForCable = nullptr;
@@ -0,0 +1,160 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    RealtimePool.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealtimePool.h"
+#include "SynthGlobals.h"
+
+RealtimePool::SizeClass RealtimePool::sSizeClasses[];
+std::atomic<bool> RealtimePool::sInitialized{ false };
+std::atomic<int> RealtimePool::sOversizeCount{ 0 };
+
+namespace
+{
+   //blocks per size class, smallest (32 bytes) to largest (8k). about 3.5MB in total.
+   const uint32_t kBlockCounts[RealtimePool::kNumSizeClasses] = { 4096, 4096, 2048, 2048, 1024, 512, 256, 128, 64 };
+}
+
+void RealtimePool::SizeClass::Init(std::size_t blockSize, uint32_t numBlocks)
+{
+   mBlockSize = blockSize;
+   mNumBlocks = numBlocks;
+   mSlab = static_cast<char*>(::operator new(blockSize * numBlocks));
+   mNext = new std::atomic<uint32_t>[numBlocks];
+   for (uint32_t i = 0; i < numBlocks; ++i)
+      mNext[i].store(i + 1 < numBlocks ? i + 1 : kEmpty, std::memory_order_relaxed);
+   mHead.store(0, std::memory_order_release);
+}
+
+void* RealtimePool::SizeClass::Pop()
+{
+   uint64_t head = mHead.load(std::memory_order_acquire);
+   while (true)
+   {
+      uint32_t index = (uint32_t)head;
+      if (index == kEmpty)
+         return nullptr;
+      uint64_t tag = (head >> 32) + 1;
+      uint64_t newHead = (tag << 32) | mNext[index].load(std::memory_order_relaxed);
+      if (mHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+         int inUse = mInUse.fetch_add(1, std::memory_order_relaxed) + 1;
+         int highWater = mHighWater.load(std::memory_order_relaxed);
+         while (inUse > highWater && !mHighWater.compare_exchange_weak(highWater, inUse, std::memory_order_relaxed))
+         {
+         }
+         return mSlab + index * mBlockSize;
+      }
+   }
+}
+
+void RealtimePool::SizeClass::Push(void* ptr)
+{
+   uint32_t index = (uint32_t)((static_cast<char*>(ptr) - mSlab) / mBlockSize);
+   uint64_t head = mHead.load(std::memory_order_relaxed);
+   uint64_t newHead;
+   do
+   {
+      mNext[index].store((uint32_t)head, std::memory_order_relaxed);
+      newHead = (((head >> 32) + 1) << 32) | index;
+   } while (!mHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+   mInUse.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool RealtimePool::SizeClass::Owns(const void* ptr) const
+{
+   const char* p = static_cast<const char*>(ptr);
+   return mSlab != nullptr && p >= mSlab && p < mSlab + mBlockSize * mNumBlocks;
+}
+
+//static
+void RealtimePool::Init()
+{
+   if (sInitialized)
+      return;
+
+   std::size_t blockSize = kMinBlockSize;
+   for (int i = 0; i < kNumSizeClasses; ++i)
+   {
+      sSizeClasses[i].Init(blockSize, kBlockCounts[i]);
+      blockSize *= 2;
+   }
+   sInitialized.store(true, std::memory_order_release);
+}
+
+//static
+int RealtimePool::GetSizeClassIndex(std::size_t bytes)
+{
+   std::size_t blockSize = kMinBlockSize;
+   for (int i = 0; i < kNumSizeClasses; ++i)
+   {
+      if (bytes <= blockSize)
+         return i;
+      blockSize *= 2;
+   }
+   return -1;
+}
+
+//static
+void* RealtimePool::Allocate(std::size_t bytes)
+{
+   int sizeClass = GetSizeClassIndex(bytes);
+   if (sizeClass == -1)
+   {
+      ++sOversizeCount;
+   }
+   else if (sInitialized.load(std::memory_order_acquire))
+   {
+      void* ptr = sSizeClasses[sizeClass].Pop();
+      if (ptr != nullptr)
+         return ptr;
+      ++sSizeClasses[sizeClass].mFallbackCount;
+   }
+   return ::operator new(bytes);
+}
+
+//static
+void RealtimePool::Free(void* ptr, std::size_t bytes)
+{
+   if (ptr == nullptr)
+      return;
+
+   int sizeClass = GetSizeClassIndex(bytes);
+   if (sizeClass != -1 && sSizeClasses[sizeClass].Owns(ptr))
+      sSizeClasses[sizeClass].Push(ptr);
+   else
+      ::operator delete(ptr);
+}
+
+//static
+void RealtimePool::LogStats()
+{
+   for (int i = 0; i < kNumSizeClasses; ++i)
+   {
+      const SizeClass& sizeClass = sSizeClasses[i];
+      ofLog() << "realtime pool " << sizeClass.mBlockSize << "b: " << sizeClass.mInUse.load() << "/" << sizeClass.mNumBlocks << " in use, high water " << sizeClass.mHighWater.load() << ", fallbacks " << sizeClass.mFallbackCount.load();
+   }
+   ofLog() << "realtime pool oversize allocations: " << sOversizeCount.load();
+}
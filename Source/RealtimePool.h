@@ -0,0 +1,103 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    RealtimePool.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+//fixed-size block pools that are allocated once at startup, so containers that grow on the audio thread don't have to go to the system heap
+//allocation and free are lock-free. requests that are too large, or that find their pool empty, fall back to operator new and are counted.
+class RealtimePool
+{
+public:
+   static void Init();
+   static void* Allocate(std::size_t bytes);
+   static void Free(void* ptr, std::size_t bytes);
+   static void LogStats();
+
+   static const int kNumSizeClasses = 9;
+   static const std::size_t kMinBlockSize = 32;
+
+private:
+   class SizeClass
+   {
+   public:
+      void Init(std::size_t blockSize, uint32_t numBlocks);
+      void* Pop();
+      void Push(void* ptr);
+      bool Owns(const void* ptr) const;
+
+      std::size_t mBlockSize{ 0 };
+      uint32_t mNumBlocks{ 0 };
+      std::atomic<int> mInUse{ 0 };
+      std::atomic<int> mHighWater{ 0 };
+      std::atomic<int> mFallbackCount{ 0 };
+
+   private:
+      static const uint32_t kEmpty = 0xffffffff;
+
+      char* mSlab{ nullptr };
+      std::atomic<uint32_t>* mNext{ nullptr };
+      std::atomic<uint64_t> mHead{ kEmpty }; //low 32 bits are the top block index, high 32 bits are a tag to avoid ABA
+   };
+
+   static int GetSizeClassIndex(std::size_t bytes);
+
+   static SizeClass sSizeClasses[kNumSizeClasses];
+   static std::atomic<bool> sInitialized;
+   static std::atomic<int> sOversizeCount;
+};
+
+//STL allocator that draws from RealtimePool, e.g. std::vector<Foo, RealtimeAllocator<Foo>>
+template <typename T>
+class RealtimeAllocator
+{
+public:
+   using value_type = T;
+
+   RealtimeAllocator() = default;
+   template <typename U>
+   RealtimeAllocator(const RealtimeAllocator<U>&) noexcept {}
+
+   T* allocate(std::size_t n)
+   {
+      static_assert(alignof(T) <= alignof(std::max_align_t), "RealtimeAllocator doesn't support over-aligned types");
+      return static_cast<T*>(RealtimePool::Allocate(n * sizeof(T)));
+   }
+
+   void deallocate(T* ptr, std::size_t n) noexcept
+   {
+      RealtimePool::Free(ptr, n * sizeof(T));
+   }
+
+   template <typename U>
+   bool operator==(const RealtimeAllocator<U>&) const noexcept { return true; }
+   template <typename U>
+   bool operator!=(const RealtimeAllocator<U>&) const noexcept { return false; }
+};
@@ -0,0 +1,225 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    RealtimeSafetyMonitor.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealtimeSafetyMonitor.h"
+#include "SynthGlobals.h"
+#include "IAudioSource.h"
+#include "IDrawableModule.h"
+
+#include <cstring>
+
+#include "juce_core/juce_core.h"
+
+RealtimeSafetyMonitor::Entry RealtimeSafetyMonitor::sEntries[];
+std::atomic<int> RealtimeSafetyMonitor::sNumEntries{ 0 };
+std::atomic<int> RealtimeSafetyMonitor::sDroppedCount{ 0 };
+bool RealtimeSafetyMonitor::sEnabled = false;
+const char* RealtimeSafetyMonitor::sContext = nullptr;
+
+namespace
+{
+   //capturing a callstack allocates, so don't let the monitor report on itself
+   thread_local bool tInsideMonitor = false;
+}
+
+//static
+void RealtimeSafetyMonitor::OnAllocation(std::size_t size, const char* file, int line)
+{
+   if (sEnabled)
+      Record(ViolationType::kAllocation, size, file, line);
+}
+
+//static
+void RealtimeSafetyMonitor::OnFree()
+{
+   if (sEnabled)
+      Record(ViolationType::kFree, 0, nullptr, 0);
+}
+
+//static
+void RealtimeSafetyMonitor::OnMutexLock(const char* locker)
+{
+   if (sEnabled)
+      Record(ViolationType::kMutexLock, 0, locker, 0);
+}
+
+//static
+void RealtimeSafetyMonitor::SetContext(const char* context)
+{
+   sContext = context;
+}
+
+//static
+void RealtimeSafetyMonitor::SetContextSource(IAudioSource* source)
+{
+   if (!sEnabled || source == nullptr)
+   {
+      sContext = nullptr;
+      return;
+   }
+
+   IDrawableModule* module = dynamic_cast<IDrawableModule*>(source);
+   sContext = module ? module->Name() : "<unnamed audio source>";
+}
+
+//static
+void RealtimeSafetyMonitor::Record(ViolationType type, std::size_t size, const char* detail, int line)
+{
+   if (tInsideMonitor || sContext == nullptr || !IsAudioThread())
+      return;
+
+   tInsideMonitor = true;
+
+   //only the audio thread adds entries, so this doesn't need to worry about other writers
+   int numEntries = sNumEntries.load(std::memory_order_acquire);
+   Entry* entry = nullptr;
+   for (int i = 0; i < numEntries; ++i)
+   {
+      if (sEntries[i].mType == type && strncmp(sEntries[i].mContext, sContext, kMaxContextLength - 1) == 0)
+      {
+         entry = &sEntries[i];
+         break;
+      }
+   }
+
+   if (entry == nullptr)
+   {
+      if (numEntries < kMaxEntries)
+      {
+         entry = &sEntries[numEntries];
+         entry->mType = type;
+         StringCopy(entry->mContext, sContext, kMaxContextLength);
+         StringCopy(entry->mFirstDetail, detail ? detail : "", kMaxContextLength);
+         entry->mFirstLine = line;
+         StringCopy(entry->mCallstack, juce::SystemStats::getStackBacktrace().toRawUTF8(), kMaxCallstackLength);
+         entry->mCount = 0;
+         entry->mBytes = 0;
+         sNumEntries.store(numEntries + 1, std::memory_order_release);
+      }
+      else
+      {
+         ++sDroppedCount;
+      }
+   }
+
+   if (entry != nullptr)
+   {
+      ++entry->mCount;
+      entry->mBytes += size;
+   }
+
+   tInsideMonitor = false;
+}
+
+//static
+const char* RealtimeSafetyMonitor::GetTypeName(ViolationType type)
+{
+   switch (type)
+   {
+      case ViolationType::kAllocation: return "allocation";
+      case ViolationType::kFree: return "free";
+      case ViolationType::kMutexLock: return "mutex lock";
+   }
+   return "";
+}
+
+//static
+void RealtimeSafetyMonitor::ToggleMonitor()
+{
+   if (!sEnabled)
+      Clear();
+   sEnabled = !sEnabled;
+}
+
+//static
+void RealtimeSafetyMonitor::Clear()
+{
+   //only safe to call while the monitor is disabled, since the audio thread may be filling in entries
+   assert(!sEnabled);
+   sNumEntries = 0;
+   sDroppedCount = 0;
+}
+
+//static
+void RealtimeSafetyMonitor::Draw()
+{
+   if (!sEnabled)
+      return;
+
+   ofPushMatrix();
+   ofTranslate(ofGetWidth() - 450, 70);
+   ofPushStyle();
+
+   int numEntries = sNumEntries.load(std::memory_order_acquire);
+   ofSetColor(255, 255, 255);
+   gFont.DrawString("audio thread violations: " + ofToString(numEntries), 15, 0, 0);
+   ofTranslate(0, 18);
+
+   for (int i = 0; i < numEntries; ++i)
+   {
+      const Entry& entry = sEntries[i];
+      if (entry.mType == ViolationType::kMutexLock)
+         ofSetColor(255, 200, 0);
+      else
+         ofSetColor(255, 80, 80);
+      std::string line = std::string(entry.mContext) + ": " + GetTypeName(entry.mType) + " x" + ofToString(entry.mCount.load());
+      if (entry.mType == ViolationType::kAllocation)
+         line += " (" + ofToString((int)entry.mBytes.load()) + " bytes)";
+      gFont.DrawString(line, 13, 0, 0);
+      ofTranslate(0, 15);
+   }
+
+   ofPopStyle();
+   ofPopMatrix();
+}
+
+//static
+bool RealtimeSafetyMonitor::WriteReport(const std::string& path)
+{
+   int numEntries = sNumEntries.load(std::memory_order_acquire);
+
+   juce::String report;
+   report << "audio thread realtime safety report\n";
+   report << numEntries << " violation sites, " << sDroppedCount.load() << " dropped\n\n";
+   for (int i = 0; i < numEntries; ++i)
+   {
+      const Entry& entry = sEntries[i];
+      report << entry.mContext << ": " << GetTypeName(entry.mType) << " x" << entry.mCount.load();
+      if (entry.mType == ViolationType::kAllocation)
+         report << " (" << (juce::int64)entry.mBytes.load() << " bytes)";
+      report << "\n";
+      if (entry.mFirstDetail[0] != 0)
+      {
+         report << "   first seen at: " << entry.mFirstDetail;
+         if (entry.mFirstLine > 0)
+            report << ":" << entry.mFirstLine;
+         report << "\n";
+      }
+      report << "   callstack:\n" << entry.mCallstack << "\n";
+   }
+
+   return juce::File(path).replaceWithText(report);
+}
@@ -0,0 +1,86 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    RealtimeSafetyMonitor.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+class IAudioSource;
+
+//records heap allocations, frees and mutex locks made on the audio thread while modules are being processed
+//allocation tracking needs the global operator new hooks, which are compiled in with BESPOKE_DEBUG_ALLOCATIONS or BESPOKE_DEBUG_REALTIME_SAFETY
+class RealtimeSafetyMonitor
+{
+public:
+   enum class ViolationType
+   {
+      kAllocation,
+      kFree,
+      kMutexLock
+   };
+
+   static void OnAllocation(std::size_t size, const char* file = nullptr, int line = 0);
+   static void OnFree();
+   static void OnMutexLock(const char* locker);
+
+   //what the audio thread is currently working on, so violations can be attributed to it. set to nullptr outside of processing.
+   static void SetContext(const char* context);
+   static void SetContextSource(IAudioSource* source);
+   static void ClearContext() { sContext = nullptr; }
+
+   static void ToggleMonitor();
+   static bool IsEnabled() { return sEnabled; }
+   static void Clear();
+   static void Draw();
+   static bool WriteReport(const std::string& path);
+
+   static const int kMaxEntries = 256;
+   static const int kMaxContextLength = 64;
+   static const int kMaxCallstackLength = 2048;
+
+private:
+   static void Record(ViolationType type, std::size_t size, const char* detail, int line);
+   static const char* GetTypeName(ViolationType type);
+
+   struct Entry
+   {
+      ViolationType mType{ ViolationType::kAllocation };
+      char mContext[kMaxContextLength]{};
+      char mFirstDetail[kMaxContextLength]{};
+      int mFirstLine{ 0 };
+      char mCallstack[kMaxCallstackLength]{};
+      std::atomic<int> mCount{ 0 };
+      std::atomic<std::size_t> mBytes{ 0 };
+   };
+
+   static Entry sEntries[kMaxEntries];
+   static std::atomic<int> sNumEntries;
+   static std::atomic<int> sDroppedCount;
+   static bool sEnabled;
+   static const char* sContext;
+};
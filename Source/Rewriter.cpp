@@ -100,11 +100,10 @@ void Rewriter::Process(double time)
    {
       mRecordBuffer.WriteChunk(GetBuffer()->GetChannel(ch), bufferSize, ch);
 
-      Add(target->GetBuffer()->GetChannel(ch), GetBuffer()->GetChannel(ch), bufferSize);
-
       GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), bufferSize, ch);
    }
 
+   GetBuffer()->MixInto(target->GetBuffer(), GetBuffer()->NumActiveChannels());
    GetBuffer()->Reset();
 }
 
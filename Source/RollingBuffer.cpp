@@ -35,10 +35,54 @@ RollingBuffer::~RollingBuffer()
 {
 }
 
+namespace
+{
+   const double kCaptureRequestTimeoutMs = 250; //readers request every frame they draw, so this only needs to ride out slow frames
+   const int kCoarseDecimation = 4;
+}
+
+void RollingBuffer::RequestCapture(CaptureDemand demand)
+{
+   if (demand == CaptureDemand::kFull)
+      mLastFullRequestTime = gTime;
+   else
+      mLastCoarseRequestTime = gTime;
+}
+
+int RollingBuffer::UpdateCaptureDecimation()
+{
+   if (!mDemandDriven)
+      return 1;
+
+   if (gTime != mCaptureDecisionTime) //once per block
+   {
+      mCaptureDecisionTime = gTime;
+      int decimation = 0;
+      if (gTime - mLastFullRequestTime < kCaptureRequestTimeoutMs)
+         decimation = 1;
+      else if (gTime - mLastCoarseRequestTime < kCaptureRequestTimeoutMs)
+         decimation = kCoarseDecimation;
+
+      if (decimation != mCaptureDecimation)
+      {
+         //start over rather than show the old contents at the wrong rate, or show stale audio when capture resumes
+         ClearBuffer();
+         for (int i = 0; i < ChannelBuffer::kMaxNumChannels; ++i)
+            mDecimationSkip[i] = 0;
+         mCaptureDecimation = decimation;
+      }
+   }
+
+   return mCaptureDecimation;
+}
+
 float RollingBuffer::GetSample(int samplesAgo, int channel)
 {
    assert(samplesAgo >= 0);
    assert(samplesAgo < Size());
+   int decimation = mCaptureDecimation;
+   if (decimation > 1)
+      samplesAgo /= decimation;
    return mBuffer.GetChannel(channel)[(Size() + mOffsetToNow[channel] - samplesAgo) % Size()];
 }
 
@@ -72,6 +116,18 @@ void RollingBuffer::WriteChunk(float* samples, int size, int channel)
 {
    assert(size < Size());
 
+   int decimation = UpdateCaptureDecimation();
+   if (decimation == 0)
+      return;
+   if (decimation > 1)
+   {
+      int i = mDecimationSkip[channel];
+      for (; i < size; i += decimation)
+         PushSample(samples[i], channel);
+      mDecimationSkip[channel] = i - size;
+      return;
+   }
+
    int wrapSamples = (mOffsetToNow[channel] + size) - Size();
    if (wrapSamples <= 0) //no wraparound
    {
@@ -89,6 +145,24 @@ void RollingBuffer::WriteChunk(float* samples, int size, int channel)
 }
 
 void RollingBuffer::Write(float sample, int channel)
+{
+   int decimation = UpdateCaptureDecimation();
+   if (decimation == 0)
+      return;
+   if (decimation > 1)
+   {
+      if (mDecimationSkip[channel] > 0)
+      {
+         --mDecimationSkip[channel];
+         return;
+      }
+      mDecimationSkip[channel] = decimation - 1;
+   }
+
+   PushSample(sample, channel);
+}
+
+void RollingBuffer::PushSample(float sample, int channel)
 {
    mBuffer.GetChannel(channel)[mOffsetToNow[channel]] = sample;
    mOffsetToNow[channel] = (mOffsetToNow[channel] + 1) % Size();
@@ -26,6 +26,7 @@
 #ifndef __modularSynth__RollingBuffer__
 #define __modularSynth__RollingBuffer__
 
+#include <atomic>
 #include <iostream>
 #include "FileStream.h"
 #include "ChannelBuffer.h"
@@ -33,6 +34,12 @@
 class RollingBuffer
 {
 public:
+   enum class CaptureDemand
+   {
+      kCoarse, //enough to show activity and levels
+      kFull
+   };
+
    RollingBuffer(int sizeInSamples);
    ~RollingBuffer();
    float GetSample(int samplesAgo, int channel);
@@ -48,12 +55,27 @@ public:
    void SetNumChannels(int channels) { mBuffer.SetNumActiveChannels(channels); }
    int NumChannels() const { return mBuffer.NumActiveChannels(); }
 
+   //for buffers that only feed the UI. writes are dropped unless a reader has called RequestCapture() recently, and decimated if only coarse reads were requested.
+   //decimated buffers cover a longer span with the same Size(), and should only be read through GetSample()
+   void SetDemandDriven(bool demandDriven) { mDemandDriven = demandDriven; }
+   void RequestCapture(CaptureDemand demand);
+
    void SaveState(FileStreamOut& out);
    void LoadState(FileStreamIn& in);
 
 private:
+   int UpdateCaptureDecimation();
+   void PushSample(float sample, int channel);
+
    int mOffsetToNow[ChannelBuffer::kMaxNumChannels]{};
    ChannelBuffer mBuffer;
+
+   bool mDemandDriven{ false };
+   std::atomic<double> mLastCoarseRequestTime{ -1e9 };
+   std::atomic<double> mLastFullRequestTime{ -1e9 };
+   std::atomic<int> mCaptureDecimation{ 1 }; //0 while nothing is reading
+   double mCaptureDecisionTime{ -1 };
+   int mDecimationSkip[ChannelBuffer::kMaxNumChannels]{}; //samples to skip before the next decimated write
 };
 
 #endif /* defined(__modularSynth__RollingBuffer__) */
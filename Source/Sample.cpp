@@ -34,6 +34,7 @@
 
 Sample::Sample()
 {
+   mData.EnablePeakPyramid();
 }
 
 Sample::~Sample()
@@ -49,6 +50,7 @@ bool Sample::Read(const char* path, bool mono, ReadType readType)
 
    juce::File file(ofToDataPath(mReadPath));
    delete mReader;
+   mAnalysis.reset();
    mReader = TheSynth->GetAudioFormatManager().createReaderFor(file);
 
    if (mReader != nullptr)
@@ -103,6 +105,9 @@ void Sample::FinishRead()
       for (int ch = 0; ch < mReadBuffer->getNumChannels(); ++ch)
          BufferCopy(mData.GetChannel(ch), mReadBuffer->getReadPointer(ch), mReadBuffer->getNumSamples());
    }
+   mData.InvalidatePeaks();
+
+   RequestAnalysis();
 }
 
 //juce::Timer
@@ -127,6 +132,7 @@ void Sample::Create(int length)
    mData.Resize(length);
    mData.SetNumActiveChannels(1);
    Setup(length);
+   mAnalysis.reset();
 }
 
 void Sample::Create(ChannelBuffer* data)
@@ -138,6 +144,7 @@ void Sample::Create(ChannelBuffer* data)
    for (int ch = 0; ch < channels; ++ch)
       BufferCopy(mData.GetChannel(ch), data->GetChannel(ch), length);
    Setup(length);
+   mAnalysis.reset();
 }
 
 void Sample::Setup(int length)
@@ -312,6 +319,19 @@ void Sample::CopyFrom(Sample* sample)
    mStopPoint = sample->mStopPoint;
    mName = sample->mName;
    mReadPath = sample->mReadPath;
+   mAnalysis = sample->mAnalysis;
+}
+
+void Sample::RequestAnalysis()
+{
+   mAnalysis = SampleAnalyzer::Analyze(&mData, mNumSamples, mOriginalSampleRate);
+}
+
+const SampleAnalysis* Sample::GetAnalysis()
+{
+   if (mAnalysis == nullptr && mNumSamples > 0 && !IsSampleLoading())
+      RequestAnalysis();
+   return mAnalysis ? mAnalysis->GetResult() : nullptr;
 }
 
 namespace
@@ -371,4 +391,6 @@ void Sample::LoadState(FileStreamIn& in)
    in >> mStopPoint;
    in >> mName;
    in >> mReadPath;
+
+   mAnalysis.reset(); //analyzed on demand, so mapped sample data isn't paged in just for this
 }
@@ -28,6 +28,7 @@
 
 #include "OpenFrameworksPort.h"
 #include "ChannelBuffer.h"
+#include "SampleAnalyzer.h"
 #include <limits>
 
 #include "juce_events/juce_events.h"
@@ -87,6 +88,8 @@ public:
    void CopyFrom(Sample* sample);
    bool IsSampleLoading() { return mSamplesLeftToRead > 0; }
    float GetSampleLoadProgress() { return (mNumSamples > 0) ? (1 - (float(mSamplesLeftToRead) / mNumSamples)) : 1; }
+   void RequestAnalysis();
+   const SampleAnalysis* GetAnalysis(); //starts the analysis if it hasn't been yet, nullptr until it has finished
 
    void SaveState(FileStreamOut& out);
    void LoadState(FileStreamIn& in);
@@ -116,6 +119,7 @@ private:
    juce::AudioFormatReader* mReader{};
    std::unique_ptr<juce::AudioSampleBuffer> mReadBuffer;
    int mSamplesLeftToRead{ 0 };
+   std::shared_ptr<SampleAnalyzer::Request> mAnalysis;
 };
 
 #endif /* defined(__modularSynth__Sample__) */
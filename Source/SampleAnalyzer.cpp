@@ -0,0 +1,367 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleAnalyzer.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SampleAnalyzer.h"
+#include "ChannelBuffer.h"
+#include "FFT.h"
+#include "SynthGlobals.h"
+
+#include <algorithm>
+#include <cmath>
+
+std::mutex SampleAnalyzer::sMutex;
+std::condition_variable SampleAnalyzer::sWakeUp;
+std::deque<std::shared_ptr<SampleAnalyzer::Request>> SampleAnalyzer::sQueue;
+std::thread SampleAnalyzer::sThread;
+bool SampleAnalyzer::sQuit = false;
+std::map<uint64_t, std::shared_ptr<const SampleAnalysis>> SampleAnalyzer::sCache;
+std::deque<uint64_t> SampleAnalyzer::sCacheOrder;
+
+namespace
+{
+   const int kFFTSize = 1024;
+   const int kHopSize = 512;
+   const int kThresholdRadius = 8; //frames on each side used for the adaptive onset threshold
+   const float kMinOnsetSpacingMs = 50;
+   const float kMinTempo = 60;
+   const float kMaxTempo = 200;
+}
+
+std::vector<int> SampleAnalysis::GetStrongestOnsets(int maxCount) const
+{
+   if ((int)mOnsets.size() <= maxCount)
+      return mOnsets;
+
+   std::vector<int> indices(mOnsets.size());
+   for (size_t i = 0; i < indices.size(); ++i)
+      indices[i] = (int)i;
+   std::partial_sort(indices.begin(), indices.begin() + maxCount, indices.end(), [this](int a, int b)
+                     { return mOnsetStrengths[a] > mOnsetStrengths[b]; });
+
+   std::vector<int> onsets;
+   for (int i = 0; i < maxCount; ++i)
+      onsets.push_back(mOnsets[indices[i]]);
+   std::sort(onsets.begin(), onsets.end());
+   return onsets;
+}
+
+//static
+std::shared_ptr<SampleAnalyzer::Request> SampleAnalyzer::Analyze(ChannelBuffer* data, int numSamples, int sampleRate)
+{
+   auto request = std::make_shared<Request>();
+   request->mSampleRate = sampleRate;
+
+   numSamples = MIN(numSamples, data->BufferSize());
+   if (numSamples <= 0)
+   {
+      request->mResult = std::make_shared<SampleAnalysis>();
+      request->mDone = true;
+      return request;
+   }
+
+   //mix down to mono here, so the worker never touches the sample itself
+   request->mData.resize(numSamples);
+   int numChannels = data->NumActiveChannels();
+   for (int ch = 0; ch < numChannels; ++ch)
+   {
+      const float* channel = data->GetChannel(ch);
+      for (int i = 0; i < numSamples; ++i)
+         request->mData[i] += channel[i] / numChannels;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(sMutex);
+      if (sQuit)
+         return request;
+      sQueue.push_back(request);
+      if (!sThread.joinable())
+         sThread = std::thread(ThreadProc);
+   }
+   sWakeUp.notify_one();
+
+   return request;
+}
+
+//static
+void SampleAnalyzer::Shutdown()
+{
+   {
+      std::lock_guard<std::mutex> lock(sMutex);
+      sQuit = true;
+      sQueue.clear();
+   }
+   sWakeUp.notify_one();
+   if (sThread.joinable())
+      sThread.join();
+}
+
+//static
+void SampleAnalyzer::ThreadProc()
+{
+   while (true)
+   {
+      std::shared_ptr<Request> request;
+      {
+         std::unique_lock<std::mutex> lock(sMutex);
+         sWakeUp.wait(lock, []
+                      { return sQuit || !sQueue.empty(); });
+         if (sQuit)
+            return;
+         request = sQueue.front();
+         sQueue.pop_front();
+      }
+
+      if (request.use_count() == 1)
+         continue; //the sample went away before we got to it
+
+      uint64_t hash = GetContentHash(request->mData, request->mSampleRate);
+      std::shared_ptr<const SampleAnalysis> result;
+      {
+         std::lock_guard<std::mutex> lock(sMutex);
+         auto cached = sCache.find(hash);
+         if (cached != sCache.end())
+            result = cached->second;
+      }
+
+      if (result == nullptr)
+      {
+         result = RunAnalysis(request->mData, request->mSampleRate);
+
+         std::lock_guard<std::mutex> lock(sMutex);
+         sCache[hash] = result;
+         sCacheOrder.push_back(hash);
+         while ((int)sCacheOrder.size() > kMaxCachedResults)
+         {
+            sCache.erase(sCacheOrder.front());
+            sCacheOrder.pop_front();
+         }
+      }
+
+      request->mResult = result;
+      request->mData.clear();
+      request->mData.shrink_to_fit();
+      request->mDone = true;
+   }
+}
+
+//static
+uint64_t SampleAnalyzer::GetContentHash(const std::vector<float>& data, int sampleRate)
+{
+   //FNV-1a
+   uint64_t hash = 14695981039346656037ull;
+   auto addByte = [&hash](uint8_t byte)
+   {
+      hash ^= byte;
+      hash *= 1099511628211ull;
+   };
+
+   for (int i = 0; i < 4; ++i)
+      addByte(uint8_t(sampleRate >> (i * 8)));
+   const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+   size_t numBytes = data.size() * sizeof(float);
+   for (size_t i = 0; i < numBytes; ++i)
+      addByte(bytes[i]);
+   return hash;
+}
+
+//static
+std::shared_ptr<SampleAnalysis> SampleAnalyzer::RunAnalysis(const std::vector<float>& data, int sampleRate)
+{
+   auto analysis = std::make_shared<SampleAnalysis>();
+   int length = (int)data.size();
+
+   for (int start = 0; start < length; start += SampleAnalysis::kEnvelopeHopSize)
+   {
+      int end = MIN(start + SampleAnalysis::kEnvelopeHopSize, length);
+      float sumSquares = 0;
+      float peak = 0;
+      for (int i = start; i < end; ++i)
+      {
+         sumSquares += data[i] * data[i];
+         peak = MAX(peak, fabsf(data[i]));
+      }
+      analysis->mRmsEnvelope.push_back(sqrtf(sumSquares / (end - start)));
+      analysis->mPeakEnvelope.push_back(peak);
+   }
+
+   //spectral flux: how much the log magnitude spectrum rises from one frame to the next
+   int numFrames = length / kHopSize;
+   if (numFrames < kThresholdRadius * 2)
+      return analysis;
+
+   FFT fft(kFFTSize);
+   const int kNumBins = kFFTSize / 2 + 1;
+   std::vector<float> window(kFFTSize);
+   for (int i = 0; i < kFFTSize; ++i)
+      window[i] = .5f - .5f * cosf(FTWO_PI * i / kFFTSize);
+   std::vector<float> frame(kFFTSize);
+   std::vector<float> real(kNumBins);
+   std::vector<float> imaginary(kNumBins);
+   std::vector<float> previous(kNumBins, 0);
+   std::vector<float> flux(numFrames, 0);
+   for (int f = 0; f < numFrames; ++f)
+   {
+      int frameStart = f * kHopSize - kFFTSize / 2; //centered on the hop position
+      for (int i = 0; i < kFFTSize; ++i)
+      {
+         int pos = frameStart + i;
+         frame[i] = (pos >= 0 && pos < length) ? data[pos] * window[i] : 0;
+      }
+      fft.Forward(frame.data(), real.data(), imaginary.data());
+
+      float sum = 0;
+      for (int bin = 0; bin < kNumBins; ++bin)
+      {
+         float magnitude = logf(1 + 10 * sqrtf(real[bin] * real[bin] + imaginary[bin] * imaginary[bin]));
+         if (magnitude > previous[bin])
+            sum += magnitude - previous[bin];
+         previous[bin] = magnitude;
+      }
+      flux[f] = sum;
+   }
+
+   //onsets are local maxima that stand out from their neighborhood
+   float maxFlux = *std::max_element(flux.begin(), flux.end());
+   if (maxFlux <= 0)
+      return analysis;
+   int minSpacing = MAX(1, int(kMinOnsetSpacingMs / 1000 * sampleRate / kHopSize));
+   int lastOnset = -minSpacing;
+   for (int f = 0; f < numFrames; ++f)
+   {
+      if ((f > 0 && flux[f] < flux[f - 1]) || (f < numFrames - 1 && flux[f] <= flux[f + 1]))
+         continue;
+
+      int from = MAX(0, f - kThresholdRadius);
+      int to = MIN(numFrames - 1, f + kThresholdRadius);
+      float mean = 0;
+      for (int i = from; i <= to; ++i)
+         mean += flux[i];
+      mean /= to - from + 1;
+
+      if (flux[f] > mean * 1.5f + maxFlux * .05f && f - lastOnset >= minSpacing)
+      {
+         analysis->mOnsets.push_back(f * kHopSize);
+         analysis->mOnsetStrengths.push_back(flux[f]);
+         lastOnset = f;
+      }
+   }
+
+   //tempo from the autocorrelation of the flux, weighted towards 120bpm to settle double/half tempo ambiguity
+   float framesPerSecond = float(sampleRate) / kHopSize;
+   int minLag = MAX(1, int(framesPerSecond * 60 / kMaxTempo));
+   int maxLag = int(framesPerSecond * 60 / kMinTempo);
+   if (numFrames < maxLag * 2)
+      return analysis;
+
+   float meanFlux = 0;
+   for (float value : flux)
+      meanFlux += value;
+   meanFlux /= numFrames;
+   std::vector<float> centered(numFrames);
+   for (int f = 0; f < numFrames; ++f)
+      centered[f] = flux[f] - meanFlux;
+
+   std::vector<float> scores(maxLag + 2, 0);
+   int bestLag = 0;
+   for (int lag = minLag; lag <= maxLag; ++lag)
+   {
+      float sum = 0;
+      for (int f = 0; f + lag < numFrames; ++f)
+         sum += centered[f] * centered[f + lag];
+      sum /= numFrames - lag;
+      float octavesFrom120 = log2f(framesPerSecond * 60 / lag / 120);
+      scores[lag] = sum * expf(-.5f * octavesFrom120 * octavesFrom120);
+      if (bestLag == 0 || scores[lag] > scores[bestLag])
+         bestLag = lag;
+   }
+   if (bestLag == 0 || scores[bestLag] <= 0)
+      return analysis;
+
+   float beatFrames = bestLag;
+   if (bestLag > minLag && bestLag < maxLag)
+   {
+      float before = scores[bestLag - 1];
+      float after = scores[bestLag + 1];
+      float denominator = before - 2 * scores[bestLag] + after;
+      if (denominator < 0)
+         beatFrames += .5f * (before - after) / denominator;
+   }
+   analysis->mBeatLength = beatFrames * kHopSize;
+   analysis->mTempo = 60.0f * sampleRate / analysis->mBeatLength;
+
+   //beat phase is the offset whose grid lands on the most onset strength, allowing a frame either way
+   std::vector<float> onsetFlux(numFrames, 0);
+   for (size_t i = 0; i < analysis->mOnsets.size(); ++i)
+      onsetFlux[analysis->mOnsets[i] / kHopSize] = analysis->mOnsetStrengths[i];
+   float bestPhaseScore = -1;
+   for (int phase = 0; phase < bestLag; ++phase)
+   {
+      float sum = 0;
+      for (float pos = phase; pos < numFrames; pos += beatFrames)
+      {
+         int frame = int(pos + .5f);
+         float strength = 0;
+         for (int i = MAX(0, frame - 1); i <= MIN(numFrames - 1, frame + 1); ++i)
+            strength = MAX(strength, onsetFlux[i]);
+         sum += strength;
+      }
+      if (sum > bestPhaseScore)
+      {
+         bestPhaseScore = sum;
+         analysis->mBeatOffset = phase * kHopSize;
+      }
+   }
+
+   //the lag is only frame accurate, so fit a line through the onsets that fall near the grid to tighten tempo and phase
+   double sumK = 0, sumPos = 0, sumKK = 0, sumKPos = 0;
+   int numMatches = 0;
+   for (size_t i = 0; i < analysis->mOnsets.size(); ++i)
+   {
+      float beats = (analysis->mOnsets[i] - analysis->mBeatOffset) / analysis->mBeatLength;
+      int k = int(roundf(beats));
+      if (k < 0 || fabsf(beats - k) * analysis->mBeatLength > kHopSize * 2)
+         continue;
+      sumK += k;
+      sumPos += analysis->mOnsets[i];
+      sumKK += double(k) * k;
+      sumKPos += double(k) * analysis->mOnsets[i];
+      ++numMatches;
+   }
+   double denominator = numMatches * sumKK - sumK * sumK;
+   if (numMatches >= 4 && denominator > 0)
+   {
+      double slope = (numMatches * sumKPos - sumK * sumPos) / denominator;
+      double intercept = (sumPos - slope * sumK) / numMatches;
+      if (slope > analysis->mBeatLength * .9f && slope < analysis->mBeatLength * 1.1f)
+      {
+         analysis->mBeatLength = slope;
+         analysis->mTempo = 60.0f * sampleRate / analysis->mBeatLength;
+         analysis->mBeatOffset = fmod(fmod(intercept, slope) + slope, slope);
+      }
+   }
+
+   return analysis;
+}
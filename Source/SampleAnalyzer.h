@@ -0,0 +1,92 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleAnalyzer.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ChannelBuffer;
+
+struct SampleAnalysis
+{
+   static const int kEnvelopeHopSize = 512;
+
+   std::vector<int> mOnsets; //sample positions of detected transients, in order
+   std::vector<float> mOnsetStrengths; //spectral flux at each onset, for picking the strongest ones
+   float mTempo{ 0 }; //bpm, 0 if no steady pulse was found
+   float mBeatLength{ 0 }; //samples per beat
+   float mBeatOffset{ 0 }; //position of the first beat of the grid, in samples
+   std::vector<float> mRmsEnvelope; //one value per kEnvelopeHopSize samples
+   std::vector<float> mPeakEnvelope;
+
+   std::vector<int> GetStrongestOnsets(int maxCount) const;
+};
+
+//analyzes sample contents on a worker thread, so modules can place slices and cue points from the results without blocking the UI.
+//results are cached by a hash of the audio, so the same sample loaded in several places is only analyzed once.
+class SampleAnalyzer
+{
+public:
+   class Request
+   {
+   public:
+      bool IsDone() const { return mDone; }
+      const SampleAnalysis* GetResult() const { return mDone ? mResult.get() : nullptr; }
+
+   private:
+      friend class SampleAnalyzer;
+      std::vector<float> mData; //mono copy of the audio, released once analyzed
+      int mSampleRate{ 0 };
+      std::shared_ptr<const SampleAnalysis> mResult;
+      std::atomic<bool> mDone{ false };
+   };
+
+   static std::shared_ptr<Request> Analyze(ChannelBuffer* data, int numSamples, int sampleRate);
+   static void Shutdown();
+
+private:
+   static void ThreadProc();
+   static uint64_t GetContentHash(const std::vector<float>& data, int sampleRate);
+   static std::shared_ptr<SampleAnalysis> RunAnalysis(const std::vector<float>& data, int sampleRate);
+
+   static const int kMaxCachedResults = 64;
+
+   static std::mutex sMutex;
+   static std::condition_variable sWakeUp;
+   static std::deque<std::shared_ptr<Request>> sQueue;
+   static std::thread sThread;
+   static bool sQuit;
+   static std::map<uint64_t, std::shared_ptr<const SampleAnalysis>> sCache;
+   static std::deque<uint64_t> sCacheOrder;
+};
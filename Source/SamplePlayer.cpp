@@ -53,6 +53,7 @@ SamplePlayer::SamplePlayer()
 , mNoteInputBuffer(this)
 {
    mYoutubeSearch[0] = 0;
+   mDrawBuffer.EnablePeakPyramid();
 }
 
 void SamplePlayer::CreateUIControls()
@@ -103,6 +104,8 @@ void SamplePlayer::CreateUIControls()
    BUTTON(mAutoSlice16, "16");
    UIBLOCK_SHIFTRIGHT();
    BUTTON(mAutoSlice32, "32");
+   UIBLOCK_SHIFTRIGHT();
+   BUTTON(mAutoSliceOnsets, "onsets");
    UIBLOCK_SHIFTX(-45);
    UIBLOCK_NEWCOLUMN();
    CHECKBOX(mShowGridCheckbox, "show grid", &mShowGrid);
@@ -475,6 +478,41 @@ void SamplePlayer::AutoSlice(int slices)
    }
 }
 
+//one cue point per detected transient, strongest ones first if there are more than fit
+void SamplePlayer::AutoSliceOnsets()
+{
+   const SampleAnalysis* analysis = mSample != nullptr ? mSample->GetAnalysis() : nullptr;
+   if (analysis == nullptr)
+   {
+      TheSynth->LogEvent("sample analysis isn't finished yet, try again in a moment", kLogEventType_Warning);
+      return;
+   }
+
+   std::vector<int> onsets = analysis->GetStrongestOnsets((int)mSampleCuePoints.size());
+   if (onsets.empty())
+   {
+      TheSynth->LogEvent("no onsets found in this sample, leaving cue points alone", kLogEventType_Warning);
+      return;
+   }
+
+   float samplesPerSecond = gSampleRate * mSample->GetSampleRateRatio();
+   for (int i = 0; i < (int)mSampleCuePoints.size(); ++i)
+   {
+      if (i < (int)onsets.size())
+      {
+         int end = (i + 1 < (int)onsets.size()) ? onsets[i + 1] : mSample->LengthInSamples();
+         mSampleCuePoints[i].startSeconds = onsets[i] / samplesPerSecond;
+         mSampleCuePoints[i].lengthSeconds = (end - onsets[i]) / samplesPerSecond;
+         mSampleCuePoints[i].speed = 1;
+      }
+      else
+      {
+         mSampleCuePoints[i].startSeconds = 0;
+         mSampleCuePoints[i].lengthSeconds = 0;
+      }
+   }
+}
+
 void SamplePlayer::FilesDropped(std::vector<std::string> files, int x, int y)
 {
    Sample* sample = new Sample();
@@ -599,6 +637,8 @@ void SamplePlayer::ButtonClicked(ClickButton* button, double time)
       AutoSlice(16);
    if (button == mAutoSlice32)
       AutoSlice(32);
+   if (button == mAutoSliceOnsets)
+      AutoSliceOnsets();
 
    if (button == mPlayHoveredClipButton)
       PlayCuePoint(time, mHoveredCuePointIndex, 127, 1, 0);
@@ -974,6 +1014,7 @@ void SamplePlayer::DrawModule()
    mAutoSlice8->Draw();
    mAutoSlice16->Draw();
    mAutoSlice32->Draw();
+   mAutoSliceOnsets->Draw();
    mRecordingAppendModeCheckbox->Draw();
    mRecordAsClipsCheckbox->Draw();
    mRecordGate.Draw();
@@ -125,6 +125,7 @@ private:
    void PlayCuePoint(double time, int index, int velocity, float speedMult, float startOffsetSeconds);
    void RunProcess(const juce::StringArray& args);
    void AutoSlice(int slices);
+   void AutoSliceOnsets();
    void StopRecording();
 
    //IDrawableModule
@@ -203,6 +204,7 @@ private:
    ClickButton* mAutoSlice8{ nullptr };
    ClickButton* mAutoSlice16{ nullptr };
    ClickButton* mAutoSlice32{ nullptr };
+   ClickButton* mAutoSliceOnsets{ nullptr };
    ClickButton* mPlayHoveredClipButton{ nullptr };
    ClickButton* mGrabHoveredClipButton{ nullptr };
 
@@ -128,10 +128,8 @@ void Sampler::Process(double time)
 
    SyncOutputBuffer(mWriteBuffer.NumActiveChannels());
    for (int ch = 0; ch < mWriteBuffer.NumActiveChannels(); ++ch)
-   {
       GetVizBuffer()->WriteChunk(mWriteBuffer.GetChannel(ch), mWriteBuffer.BufferSize(), ch);
-      Add(target->GetBuffer()->GetChannel(ch), mWriteBuffer.GetChannel(ch), gBufferSize);
-   }
+   mWriteBuffer.MixInto(target->GetBuffer(), mWriteBuffer.NumActiveChannels());
 
    GetBuffer()->Reset();
 }
@@ -44,6 +44,8 @@ Scale::Scale()
    assert(TheScale == nullptr);
    TheScale = this;
    SetName("scale");
+
+   UpdatePitchFreqTable();
 }
 
 Scale::~Scale()
@@ -172,6 +174,43 @@ void Scale::Init()
 }
 
 float Scale::PitchToFreq(float pitch)
+{
+   const auto& table = mPitchFreqTable[mPitchFreqTableFlip];
+   float pos = (pitch - kPitchFreqTableMinPitch) * kPitchFreqTableStepsPerPitch;
+   if (!(pos >= 0 && pos < kPitchFreqTableSize - 1)) //also catches nan
+      return ComputePitchToFreq(pitch);
+
+   int index = (int)pos;
+   float remainder = pos - index;
+   return table[index] + (table[index + 1] - table[index]) * remainder;
+}
+
+void Scale::PitchToFreq(const float* pitches, float* freqsOut, int length)
+{
+   const auto& table = mPitchFreqTable[mPitchFreqTableFlip];
+   for (int i = 0; i < length; ++i)
+   {
+      float pos = (pitches[i] - kPitchFreqTableMinPitch) * kPitchFreqTableStepsPerPitch;
+      if (pos >= 0 && pos < kPitchFreqTableSize - 1)
+      {
+         int index = (int)pos;
+         float remainder = pos - index;
+         freqsOut[i] = table[index] + (table[index + 1] - table[index]) * remainder;
+      }
+      else
+      {
+         freqsOut[i] = ComputePitchToFreq(pitches[i]);
+      }
+   }
+}
+
+void Scale::PitchToPhaseInc(const float* pitches, float* phaseIncsOut, int length)
+{
+   PitchToFreq(pitches, phaseIncsOut, length);
+   Mult(phaseIncsOut, gTwoPiOverSampleRate, length);
+}
+
+float Scale::ComputePitchToFreq(float pitch)
 {
    if (mIntonation == kIntonation_SclFile)
    {
@@ -316,6 +355,9 @@ void Scale::SetRoot(int root, bool force)
 
    mScale.SetRoot(root);
 
+   if (DoesIntonationDependOnRoot())
+      UpdatePitchFreqTable();
+
    NotifyListeners();
 }
 
@@ -494,6 +536,13 @@ void Scale::Poll()
          }
       }
    }
+
+   bool tuningFieldsChanged = mReferenceFreq != mPitchFreqTableReferenceFreq ||
+                              mReferencePitch != mPitchFreqTableReferencePitch ||
+                              mPitchesPerOctave != mPitchFreqTablePitchesPerOctave;
+   bool oddsoundChanged = mIntonation == kIntonation_Oddsound && mOddsoundMTSClient != nullptr && PollOddsoundTuning();
+   if (tuningFieldsChanged || oddsoundChanged)
+      UpdatePitchFreqTable();
 }
 
 float Scale::RationalizeNumber(float input)
@@ -706,6 +755,8 @@ void Scale::UpdateTuningTable()
             mTuningTable[i] *= ratio;
       }
    }
+
+   UpdatePitchFreqTable();
 }
 
 float Scale::GetTuningTableRatio(int semitonesFromCenter)
@@ -713,6 +764,58 @@ float Scale::GetTuningTableRatio(int semitonesFromCenter)
    return mTuningTable[CLAMP(128 + semitonesFromCenter, 0, 255)];
 }
 
+void Scale::UpdatePitchFreqTable()
+{
+   if (mIntonation == kIntonation_Oddsound && mOddsoundMTSClient != nullptr)
+      PollOddsoundTuning();
+
+   mPitchFreqTableReferenceFreq = mReferenceFreq;
+   mPitchFreqTableReferencePitch = mReferencePitch;
+   mPitchFreqTablePitchesPerOctave = mPitchesPerOctave;
+
+   int flip = 1 - mPitchFreqTableFlip;
+   auto& table = mPitchFreqTable[flip];
+   for (int i = 0; i < kPitchFreqTableSize; ++i)
+      table[i] = ComputePitchToFreq(kPitchFreqTableMinPitch + float(i) / kPitchFreqTableStepsPerPitch);
+   mPitchFreqTableFlip = flip;
+}
+
+//returns true if the oddsound master has connected, disconnected, or retuned since the last call
+bool Scale::PollOddsoundTuning()
+{
+   bool changed = false;
+
+   bool hasMaster = MTS_HasMaster(mOddsoundMTSClient);
+   if (hasMaster != mOddsoundHasMaster)
+   {
+      mOddsoundHasMaster = hasMaster;
+      changed = true;
+   }
+
+   if (hasMaster)
+   {
+      for (int i = 0; i < (int)mOddsoundNoteFreqs.size(); ++i)
+      {
+         float freq = MTS_NoteToFrequency(mOddsoundMTSClient, i, 0);
+         if (freq != mOddsoundNoteFreqs[i])
+         {
+            mOddsoundNoteFreqs[i] = freq;
+            changed = true;
+         }
+      }
+   }
+
+   return changed;
+}
+
+bool Scale::DoesIntonationDependOnRoot() const
+{
+   return mIntonation == kIntonation_Just ||
+          mIntonation == kIntonation_Pythagorean ||
+          mIntonation == kIntonation_Meantone ||
+          mIntonation == kIntonation_Rational;
+}
+
 void Scale::DropdownUpdated(DropdownList* list, int oldVal, double time)
 {
    if (list == mRootSelector)
@@ -798,6 +901,10 @@ void Scale::LoadState(FileStreamIn& in, int rev)
       ofLog() << "Restoring SCL/KBM from streaming";
       UpdateTuningTable();
    }
+   else
+   {
+      UpdatePitchFreqTable();
+   }
 }
 
 void ScalePitches::SetRoot(int root)
@@ -126,6 +126,8 @@ public:
 
    float PitchToFreq(float pitch);
    float FreqToPitch(float freq);
+   void PitchToFreq(const float* pitches, float* freqsOut, int length); //freqsOut may be the same buffer as pitches
+   void PitchToPhaseInc(const float* pitches, float* phaseIncsOut, int length); //phaseIncsOut may be the same buffer as pitches
 
    const ChordDatabase& GetChordDatabase() const { return mChordDatabase; }
 
@@ -167,6 +169,10 @@ private:
    float RationalizeNumber(float input);
    void UpdateTuningTable();
    float GetTuningTableRatio(int semitonesFromCenter);
+   float ComputePitchToFreq(float pitch);
+   void UpdatePitchFreqTable();
+   bool PollOddsoundTuning();
+   bool DoesIntonationDependOnRoot() const;
    void SetRandomRootAndScale();
 
    enum IntonationMode
@@ -206,9 +212,22 @@ private:
 
    std::array<float, 256> mTuningTable{};
 
+   //PitchToFreq() results sampled at a fine pitch resolution, rebuilt whenever the tuning changes
+   static constexpr int kPitchFreqTableMinPitch = -128;
+   static constexpr int kPitchFreqTableNumPitches = 384;
+   static constexpr int kPitchFreqTableStepsPerPitch = 32;
+   static constexpr int kPitchFreqTableSize = kPitchFreqTableNumPitches * kPitchFreqTableStepsPerPitch + 1;
+   std::array<float, kPitchFreqTableSize> mPitchFreqTable[2]{}; //double-buffered to avoid thread safety issues when rebuilding
+   std::atomic<int> mPitchFreqTableFlip{ 0 };
+   float mPitchFreqTableReferenceFreq{ 0 }; //tuning fields the table was built from, TextEntry::SetValue() writes these without notifying us
+   float mPitchFreqTableReferencePitch{ 0 };
+   int mPitchFreqTablePitchesPerOctave{ 0 };
+
    ChordDatabase mChordDatabase;
 
    MTSClient* mOddsoundMTSClient{ nullptr };
+   bool mOddsoundHasMaster{ false };
+   std::array<float, 128> mOddsoundNoteFreqs{};
 
    std::string mSclContents;
    std::string mKbmContents;
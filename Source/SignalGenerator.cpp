@@ -134,6 +134,11 @@ SignalGenerator::~SignalGenerator()
 }
 
 void SignalGenerator::Process(double time)
+{
+   ProcessSpan(time, 0, gBufferSize);
+}
+
+void SignalGenerator::ProcessSpan(double time, int offset, int length)
 {
    PROFILER(SignalGenerator);
 
@@ -142,21 +147,15 @@ void SignalGenerator::Process(double time)
    if (!mEnabled || target == nullptr)
       return;
 
-   int bufferSize = target->GetBuffer()->BufferSize();
    float* out = target->GetBuffer()->GetChannel(0);
-   assert(bufferSize == gBufferSize);
+   assert(target->GetBuffer()->BufferSize() == gBufferSize);
+   assert(offset + length <= gBufferSize);
 
-   Clear(mWriteBuffer, gBufferSize);
-   for (int pos = 0; pos < bufferSize; ++pos)
+   Clear(mWriteBuffer + offset, length);
+   for (int pos = offset; pos < offset + length; ++pos)
    {
       ComputeSliders(pos);
 
-      if (mResetPhaseAtMs > 0 && time > mResetPhaseAtMs)
-      {
-         mPhase = mPhaseOffset;
-         mResetPhaseAtMs = -9999;
-      }
-
       float volSq = mVol * mVol;
 
       if (mFreqMode == kFreqMode_Root)
@@ -200,12 +199,26 @@ void SignalGenerator::Process(double time)
 
       time += gInvSampleRateMs;
    }
-   GetVizBuffer()->WriteChunk(mWriteBuffer, bufferSize, 0);
+   GetVizBuffer()->WriteChunk(mWriteBuffer + offset, length, 0);
 
-   Add(out, mWriteBuffer, bufferSize);
+   Add(out + offset, mWriteBuffer + offset, length);
+}
+
+void SignalGenerator::ApplyBlockEvent(const BlockEvent& event)
+{
+   if (event.mType == BlockEvent::Type::kPulse)
+      mPhase = mPhaseOffset;
+   else
+      ApplyNote(event.mTime, event.mPitch, (int)event.mVelocity);
 }
 
 void SignalGenerator::PlayNote(double time, int pitch, int velocity, int voiceIdx, ModulationParameters modulation)
+{
+   if (velocity > 0)
+      mBlockEvents.QueueNote(time, pitch, velocity, voiceIdx, modulation);
+}
+
+void SignalGenerator::ApplyNote(double time, int pitch, int velocity)
 {
    if (velocity > 0)
    {
@@ -238,7 +251,7 @@ void SignalGenerator::PlayNote(double time, int pitch, int velocity, int voiceId
 
 void SignalGenerator::OnPulse(double time, float velocity, int flags)
 {
-   mResetPhaseAtMs = time;
+   mBlockEvents.QueuePulse(time, velocity, flags);
 }
 
 void SignalGenerator::SetEnabled(bool enabled)
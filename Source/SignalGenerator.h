@@ -36,6 +36,7 @@
 #include "EnvOscillator.h"
 #include "Ramp.h"
 #include "IPulseReceiver.h"
+#include "BlockEventQueue.h"
 
 class ofxJSONElement;
 
@@ -56,6 +57,9 @@ public:
    //IAudioSource
    void Process(double time) override;
    void SetEnabled(bool enabled) override;
+   BlockEventQueue* GetBlockEventQueue() override { return &mBlockEvents; }
+   void ProcessSpan(double time, int offset, int length) override;
+   void ApplyBlockEvent(const BlockEvent& event) override;
 
    //INoteReceiver
    void PlayNote(double time, int pitch, int velocity, int voiceIdx = -1, ModulationParameters modulation = ModulationParameters()) override;
@@ -80,6 +84,8 @@ public:
    bool IsEnabled() const override { return mEnabled; }
 
 private:
+   void ApplyNote(double time, int pitch, int velocity);
+
    //IDrawableModule
    void DrawModule() override;
    void GetModuleDimensions(float& width, float& height) override;
@@ -131,7 +137,7 @@ private:
    FloatSlider* mSoftenSlider{ nullptr };
    float mPhaseOffset{ 0 };
    FloatSlider* mPhaseOffsetSlider{ nullptr };
-   double mResetPhaseAtMs{ -9999 };
+   BlockEventQueue mBlockEvents{ this };
 
    float* mWriteBuffer{ nullptr };
 
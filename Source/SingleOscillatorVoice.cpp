@@ -29,6 +29,7 @@
 #include "Scale.h"
 #include "Profiler.h"
 #include "ChannelBuffer.h"
+#include "CpuGovernor.h"
 
 SingleOscillatorVoice::SingleOscillatorVoice(IDrawableModule* owner)
 : mOwner(owner)
@@ -51,7 +52,10 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
    if (IsDone(time))
       return false;
 
-   for (int u = 0; u < mVoiceParams->mUnison && u < kMaxUnison; ++u)
+   mActiveUnison = MIN(CpuGovernor::GetUnison(mVoiceParams->mUnison), kMaxUnison);
+   bool liteCPUMode = mVoiceParams->mLiteCPUMode || CpuGovernor::UseBlockRateParameters();
+
+   for (int u = 0; u < mActiveUnison; ++u)
       mOscData[u].mOsc.SetType(mVoiceParams->mOscType);
 
    bool mono = (out->NumActiveChannels() == 1);
@@ -61,19 +65,19 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
    float vol;
    float syncPhaseInc;
 
-   if (mVoiceParams->mLiteCPUMode)
+   if (liteCPUMode)
       DoParameterUpdate(0, pitch, freq, vol, syncPhaseInc);
 
    for (int pos = 0; pos < out->BufferSize(); ++pos)
    {
-      if (!mVoiceParams->mLiteCPUMode)
+      if (!liteCPUMode)
          DoParameterUpdate(pos, pitch, freq, vol, syncPhaseInc);
 
       float adsrVal = mAdsr.Value(time);
 
       float summedLeft = 0;
       float summedRight = 0;
-      for (int u = 0; u < mVoiceParams->mUnison && u < kMaxUnison; ++u)
+      for (int u = 0; u < mActiveUnison; ++u)
       {
          mOscData[u].mOsc.SetPulseWidth(mVoiceParams->mPulseWidth);
          mOscData[u].mOsc.SetShuffle(mVoiceParams->mShuffle);
@@ -118,7 +122,7 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
          {
             //PROFILER(SingleOscillatorVoice_pan);
             float unisonPan;
-            if (mVoiceParams->mUnison == 1)
+            if (mActiveUnison == 1)
                unisonPan = 0;
             else if (u == 0)
                unisonPan = -1;
@@ -176,7 +180,7 @@ void SingleOscillatorVoice::DoParameterUpdate(int samplesIn,
 
    pitch = GetPitch(samplesIn);
    freq = TheScale->PitchToFreq(pitch) * mVoiceParams->mMult;
-   vol = mVoiceParams->mVol * .4f / mVoiceParams->mUnison;
+   vol = mVoiceParams->mVol * .4f / mActiveUnison;
    if (mVoiceParams->mSyncMode == Oscillator::SyncMode::Frequency)
       syncPhaseInc = GetPhaseInc(mVoiceParams->mSyncFreq);
    else if (mVoiceParams->mSyncMode == Oscillator::SyncMode::Ratio)
@@ -184,7 +188,7 @@ void SingleOscillatorVoice::DoParameterUpdate(int samplesIn,
    else
       syncPhaseInc = 0;
 
-   for (int u = 0; u < mVoiceParams->mUnison && u < kMaxUnison; ++u)
+   for (int u = 0; u < mActiveUnison; ++u)
    {
       float detune = exp2(mVoiceParams->mDetune * mOscData[u].mDetuneFactor * (1 - GetPressure(samplesIn)));
       mOscData[u].mCurrentPhaseInc = GetPhaseInc(freq * detune);
@@ -100,6 +100,7 @@ private:
       float mCurrentPhaseInc{ 0 };
    };
    OscData mOscData[kMaxUnison];
+   int mActiveUnison{ 1 }; //may be fewer than the unison setting while the cpu governor is reducing quality
    ::ADSR mAdsr;
    OscillatorVoiceParams* mVoiceParams{ nullptr };
 
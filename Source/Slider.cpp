@@ -532,12 +532,116 @@ void FloatSlider::SetValue(float value, double time, bool forceUpdate /*= false*
    else*/
    *var = value;
    DisableLFO();
+   if (var == mVar && !mRelative && mModulator == nullptr)
+      QueueAutomation(value, oldVal, time);
    if (oldVal != *var || forceUpdate)
    {
       mOwner->FloatSliderUpdated(this, oldVal, time);
    }
 }
 
+//values set for a time that hasn't been rendered yet are also queued, so sliders whose owners call Compute() every sample can step through them at the right sample,
+//rather than jumping straight to the last value of a dense stream.
+//the value is still written immediately, so idle modules and the display see it straight away.
+void FloatSlider::QueueAutomation(float value, float oldValue, double time)
+{
+   if (!mComputeHasBeenCalledOnce)
+      return;
+
+   if (time <= gTime)
+   {
+      //an immediate value replaces anything still waiting to land
+      ++mAutomationGeneration;
+      return;
+   }
+
+   if (value == oldValue)
+      return;
+
+   AutomationPoint point;
+   point.mTime = time;
+   point.mValue = value;
+   point.mPreviousValue = oldValue;
+   point.mGeneration = mAutomationGeneration;
+   if (mAutomationQueue.TryEnqueue(point))
+      mAutomationQueued.store(true, std::memory_order_release);
+}
+
+void FloatSlider::ApplyAutomation(int samplesIn)
+{
+   if (!IsAudioThread())
+      return; //the audio thread is the only consumer
+
+   int generation = mAutomationGeneration;
+   if (generation != mAutomationPointsGeneration)
+   {
+      mNumAutomationPoints = 0;
+      mAutomationPointsGeneration = generation;
+   }
+
+   //clear the flag before draining, so a point queued during the drain raises it again
+   if (mAutomationQueued.exchange(false, std::memory_order_acquire))
+   {
+      AutomationPoint point;
+      while (mAutomationQueue.TryDequeue(point))
+      {
+         if (point.mGeneration != generation)
+            continue;
+
+         mAutomationHeldValue = point.mValue; //what SetValue() left in the variable
+
+         if (mNumAutomationPoints == kAutomationQueueSize)
+         {
+            //no room, drop the earliest point. the value it would have stepped through is only briefly audible anyway.
+            for (int i = 1; i < mNumAutomationPoints; ++i)
+               mAutomationPoints[i - 1] = mAutomationPoints[i];
+            --mNumAutomationPoints;
+         }
+
+         int insertAt = mNumAutomationPoints;
+         while (insertAt > 0 && mAutomationPoints[insertAt - 1].mTime > point.mTime)
+         {
+            mAutomationPoints[insertAt] = mAutomationPoints[insertAt - 1];
+            --insertAt;
+         }
+         mAutomationPoints[insertAt] = point;
+         ++mNumAutomationPoints;
+      }
+   }
+
+   if (mNumAutomationPoints == 0)
+      return;
+
+   if (*mVar != mAutomationHeldValue)
+   {
+      //something else has written the value since these were queued, it wins over the stale points
+      mNumAutomationPoints = 0;
+      return;
+   }
+
+   //the owner was already told about the final value by SetValue(), so stepping towards it doesn't notify again
+   double time = gTime + samplesIn * gInvSampleRateMs;
+   int numDue = 0;
+   while (numDue < mNumAutomationPoints && mAutomationPoints[numDue].mTime <= time)
+   {
+      *mVar = mAutomationPoints[numDue].mValue;
+      ++numDue;
+   }
+
+   if (numDue > 0)
+   {
+      for (int i = numDue; i < mNumAutomationPoints; ++i)
+         mAutomationPoints[i - numDue] = mAutomationPoints[i];
+      mNumAutomationPoints -= numDue;
+   }
+   else
+   {
+      *mVar = mAutomationPoints[0].mPreviousValue;
+   }
+
+   mAutomationHeldValue = *mVar;
+}
+
 void FloatSlider::UpdateTouching()
 {
    if (mRelative && (mModulator == nullptr || mModulator->Active() == false))
@@ -32,6 +32,10 @@
 #include "TextEntry.h"
 #include "Ramp.h"
 #include "IAudioPoller.h"
+#include "BoundedMPSCQueue.h"
+
+#include <array>
+#include <atomic>
 
 class FloatSlider;
 class FloatSliderLFOControl;
@@ -62,6 +66,8 @@ public:
    void Compute(int samplesIn = 0)
    {
       mComputeHasBeenCalledOnce = true; //mark this slider as one whose owner calls compute on it
+      if (mNumAutomationPoints > 0 || mAutomationQueued.load(std::memory_order_relaxed))
+         ApplyAutomation(samplesIn);
       if (mIsSmoothing || mModulator != nullptr)
          DoCompute(samplesIn);
    }
@@ -152,6 +158,18 @@ private:
    bool AdjustSmooth() const;
    void SmoothUpdated();
    void DoCompute(int samplesIn);
+   void QueueAutomation(float value, float oldValue, double time);
+   void ApplyAutomation(int samplesIn);
+
+   //a value set for a time that hasn't been rendered yet, applied at its sample by Compute()
+   struct AutomationPoint
+   {
+      double mTime{ 0 };
+      float mValue{ 0 };
+      float mPreviousValue{ 0 }; //what the slider holds until mTime
+      int mGeneration{ 0 }; //points queued before the latest immediate SetValue() are dropped
+   };
+   static const int kAutomationQueueSize = 16;
 
    int mWidth;
    int mHeight;
@@ -186,6 +204,14 @@ private:
    double* mLastComputeCacheTime;
    float* mLastComputeCacheValue;
 
+   BoundedMPSCQueue<AutomationPoint> mAutomationQueue{ kAutomationQueueSize };
+   std::atomic<bool> mAutomationQueued{ false };
+   std::array<AutomationPoint, kAutomationQueueSize> mAutomationPoints; //audio thread only, sorted by time
+   int mNumAutomationPoints{ 0 };
+   int mAutomationPointsGeneration{ 0 }; //audio thread only
+   float mAutomationHeldValue{ 0 }; //audio thread only, what automation last left in *mVar
+   std::atomic<int> mAutomationGeneration{ 0 };
+
    float mLastDisplayedValue{ std::numeric_limits<float>::max() };
 
    TextEntry* mFloatEntry{ nullptr };
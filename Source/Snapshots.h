@@ -35,6 +35,7 @@
 #include "Transport.h"
 #include "Slider.h"
 #include "Ramp.h"
+#include "RealtimePool.h"
 #include "INoteReceiver.h"
 #include "DropdownList.h"
 #include "TextEntry.h"
@@ -160,7 +161,7 @@ private:
    float mBlendTime{ 0 };
    FloatSlider* mBlendTimeSlider{ nullptr };
    float mBlendProgress{ 0 };
-   std::vector<ControlRamp> mBlendRamps;
+   std::vector<ControlRamp, RealtimeAllocator<ControlRamp>> mBlendRamps;
    ofMutex mRampMutex;
    int mCurrentSnapshot{ 0 };
    DropdownList* mCurrentSnapshotSelector{ nullptr };
@@ -23,7 +23,6 @@
 //
 //
 
-
 #include "SynthGlobals.h"
 #include "ModularSynth.h"
 #include "IAudioSource.h"
@@ -36,9 +35,11 @@
 #include "PatchCable.h"
 #include "PatchCableSource.h"
 #include "ChannelBuffer.h"
+#include "PeakPyramid.h"
 #include "IPulseReceiver.h"
 #include "exprtk/exprtk.hpp"
 #include "UserPrefs.h"
+#include "RealtimeSafetyMonitor.h"
 
 #include "juce_audio_formats/juce_audio_formats.h"
 #include "juce_gui_basics/juce_gui_basics.h"
@@ -130,96 +131,118 @@ std::string GetBuildInfoString()
    juce::JUCEApplication::getInstance()->getApplicationVersion().toStdString() + " (" + std::string(__DATE__) + " " + std::string(__TIME__) + ")";
 }
 
-void DrawAudioBuffer(float width, float height, ChannelBuffer* buffer, float start, float end, float pos, float vol /*=1*/, ofColor color /*=ofColor::black*/, int wraparoundFrom /*= -1*/, int wraparoundTo /*= 0*/)
+namespace
 {
-   ofPushMatrix();
-   if (buffer != nullptr)
+   void DrawAudioBufferChannel(float width, float height, const float* buffer, float start, float end, float pos, float vol, ofColor color, int wraparoundFrom, int wraparoundTo, int bufferSize, PeakPyramid* peaks)
    {
-      int numChannels = buffer->NumActiveChannels();
-      for (int i = 0; i < numChannels; ++i)
-      {
-         DrawAudioBuffer(width, height / numChannels, buffer->GetChannel(i), start, MIN(end, buffer->BufferSize()), pos, vol, color, wraparoundFrom, wraparoundTo, buffer->BufferSize());
-         ofTranslate(0, height / numChannels);
-      }
-   }
-   ofPopMatrix();
-}
+      vol = MAX(.1f, vol); //make sure we at least draw something if there is waveform data
 
-void DrawAudioBuffer(float width, float height, const float* buffer, float start, float end, float pos, float vol /*=1*/, ofColor color /*=ofColor::black*/, int wraparoundFrom /*= -1*/, int wraparoundTo /*= 0*/, int bufferSize /*=-1*/)
-{
-   vol = MAX(.1f, vol); //make sure we at least draw something if there is waveform data
+      ofPushStyle();
 
-   ofPushStyle();
+      ofSetLineWidth(1);
+      ofFill();
+      ofSetColor(255, 255, 255, 50);
+      if (width > 0)
+         ofRect(0, 0, width, height);
+      else
+         ofRect(width, 0, -width, height);
 
-   ofSetLineWidth(1);
-   ofFill();
-   ofSetColor(255, 255, 255, 50);
-   if (width > 0)
-      ofRect(0, 0, width, height);
-   else
-      ofRect(width, 0, -width, height);
+      float length = end - 1 - start;
+      if (length < 0)
+         length = length + wraparoundFrom - wraparoundTo;
+      if (length < 0)
+         length += bufferSize;
 
-   float length = end - 1 - start;
-   if (length < 0)
-      length = length + wraparoundFrom - wraparoundTo;
-   if (length < 0)
-      length += bufferSize;
+      if (length > 0)
+      {
+         const float kStepSize = 3;
+         float samplesPerStep = length / abs(width) * kStepSize;
+         start = start - (int(start) % MAX(1, int(samplesPerStep)));
 
-   if (length > 0)
-   {
-      const float kStepSize = 3;
-      float samplesPerStep = length / abs(width) * kStepSize;
-      start = start - (int(start) % MAX(1, int(samplesPerStep)));
+         if (buffer && length > 0)
+         {
+            float step = width > 0 ? kStepSize : -kStepSize;
+            float samplesPerStep = length / width * step;
 
-      if (buffer && length > 0)
-      {
-         float step = width > 0 ? kStepSize : -kStepSize;
-         float samplesPerStep = length / width * step;
+            ofSetColor(color);
 
-         ofSetColor(color);
+            //wide columns read the peak cache instead of sampling the data
+            bool usePeaks = peaks != nullptr && wraparoundFrom == -1 && samplesPerStep >= PeakPyramid::kBaseBucketSize * 2;
 
-         for (float i = 0; abs(i) < abs(width); i += step)
-         {
-            float mag = 0;
-            int position = i / width * length + start;
-            //rms
-            int j;
-            int inc = 1 + samplesPerStep / 100;
-            for (j = 0; j < samplesPerStep; j += inc)
+            for (float i = 0; abs(i) < abs(width); i += step)
             {
-               int sampleIdx = position + j;
-               if (wraparoundFrom != -1 && sampleIdx > wraparoundFrom)
-                  sampleIdx = sampleIdx - wraparoundFrom + wraparoundTo;
-               if (bufferSize > 0)
-                  sampleIdx %= bufferSize;
-               mag = MAX(mag, fabsf(buffer[sampleIdx]));
+               float mag = 0;
+               int position = i / width * length + start;
+               if (usePeaks)
+               {
+                  mag = peaks->GetPeak(position, position + (int)ceilf(samplesPerStep)).GetMagnitude();
+               }
+               else
+               {
+                  //rms
+                  int j;
+                  int inc = 1 + samplesPerStep / 100;
+                  for (j = 0; j < samplesPerStep; j += inc)
+                  {
+                     int sampleIdx = position + j;
+                     if (wraparoundFrom != -1 && sampleIdx > wraparoundFrom)
+                        sampleIdx = sampleIdx - wraparoundFrom + wraparoundTo;
+                     if (bufferSize > 0)
+                        sampleIdx %= bufferSize;
+                     mag = MAX(mag, fabsf(buffer[sampleIdx]));
+                  }
+               }
+               mag = pow(mag, .25f);
+               mag *= height / 2 * vol;
+               if (mag > height / 2)
+               {
+                  //ofSetColor(255,0,0);
+                  mag = height / 2;
+               }
+               else
+               {
+                  //ofSetColor(color);
+               }
+               if (mag == 0)
+                  mag = .1f;
+               ofLine(i, height / 2 - mag, i, height / 2 + mag);
             }
-            mag = pow(mag, .25f);
-            mag *= height / 2 * vol;
-            if (mag > height / 2)
-            {
-               //ofSetColor(255,0,0);
-               mag = height / 2;
-            }
-            else
+
+            if (pos != -1)
             {
-               //ofSetColor(color);
+               ofSetColor(0, 255, 0);
+               int position = ofMap(pos, start, end, 0, width, true);
+               ofLine(position, 0, position, height);
             }
-            if (mag == 0)
-               mag = .1f;
-            ofLine(i, height / 2 - mag, i, height / 2 + mag);
          }
+      }
 
-         if (pos != -1)
-         {
-            ofSetColor(0, 255, 0);
-            int position = ofMap(pos, start, end, 0, width, true);
-            ofLine(position, 0, position, height);
-         }
+      ofPopStyle();
+   }
+}
+
+void DrawAudioBuffer(float width, float height, ChannelBuffer* buffer, float start, float end, float pos, float vol /*=1*/, ofColor color /*=ofColor::black*/, int wraparoundFrom /*= -1*/, int wraparoundTo /*= 0*/)
+{
+   ofPushMatrix();
+   if (buffer != nullptr)
+   {
+      int numChannels = buffer->NumActiveChannels();
+      for (int i = 0; i < numChannels; ++i)
+      {
+         const float* data = buffer->GetChannel(i);
+         PeakPyramid* peaks = buffer->GetPeakPyramid(i);
+         if (peaks != nullptr)
+            peaks->Update(data, buffer->BufferSize());
+         DrawAudioBufferChannel(width, height / numChannels, data, start, MIN(end, buffer->BufferSize()), pos, vol, color, wraparoundFrom, wraparoundTo, buffer->BufferSize(), peaks);
+         ofTranslate(0, height / numChannels);
       }
    }
+   ofPopMatrix();
+}
 
-   ofPopStyle();
+void DrawAudioBuffer(float width, float height, const float* buffer, float start, float end, float pos, float vol /*=1*/, ofColor color /*=ofColor::black*/, int wraparoundFrom /*= -1*/, int wraparoundTo /*= 0*/, int bufferSize /*=-1*/)
+{
+   DrawAudioBufferChannel(width, height, buffer, start, end, pos, vol, color, wraparoundFrom, wraparoundTo, bufferSize, nullptr);
 }
 
 void Add(float* buff1, const float* buff2, int bufferSize)
@@ -11662,12 +11685,14 @@ void DumpUnfreedMemory()
 #undef new
 void* operator new(std::size_t size) throw(std::bad_alloc)
 {
+   RealtimeSafetyMonitor::OnAllocation(size);
    void* ptr = (void*)malloc(size);
    //AddTrack((uint32)ptr, size, "<unknown>", 0);
    return (ptr);
 }
 void* operator new(std::size_t size, const char* file, int line) throw(std::bad_alloc)
 {
+   RealtimeSafetyMonitor::OnAllocation(size, file, line);
    void* ptr = (void*)malloc(size);
    AddTrack((uint32)ptr, size, file, line);
    return (ptr);
@@ -11675,16 +11700,20 @@ void* operator new(std::size_t size, const char* file, int line) throw(std::bad_
 void operator delete(void* p) throw()
 {
    //RemoveTrack((uint32)p);
+   if (p != nullptr)
+      RealtimeSafetyMonitor::OnFree();
    free(p);
 }
 void* operator new[](std::size_t size) throw(std::bad_alloc)
 {
+   RealtimeSafetyMonitor::OnAllocation(size);
    void* ptr = (void*)malloc(size);
    //AddTrack((uint32)ptr, size, "<unknown>", 0);
    return (ptr);
 }
 void* operator new[](std::size_t size, const char* file, int line) throw(std::bad_alloc)
 {
+   RealtimeSafetyMonitor::OnAllocation(size, file, line);
    void* ptr = (void*)malloc(size);
    AddTrack((uint32)ptr, size, file, line);
    return (ptr);
@@ -11692,6 +11721,8 @@ void* operator new[](std::size_t size, const char* file, int line) throw(std::ba
 void operator delete[](void* p) throw()
 {
    //RemoveTrack((uint32)p);
+   if (p != nullptr)
+      RealtimeSafetyMonitor::OnFree();
    free(p);
 }
 #define new DEBUG_NEW
@@ -11703,4 +11734,38 @@ void DumpUnfreedMemory()
 {
    ofLog() << "This only works with BESPOKE_DEBUG_ALLOCATIONS defined";
 };
+
+#ifdef BESPOKE_DEBUG_REALTIME_SAFETY
+//lightweight hooks for RealtimeSafetyMonitor, without the per-allocation bookkeeping of BESPOKE_DEBUG_ALLOCATIONS
+#undef new
+void* operator new(std::size_t size)
+{
+   RealtimeSafetyMonitor::OnAllocation(size);
+   void* ptr = malloc(size);
+   if (ptr == nullptr)
+      throw std::bad_alloc();
+   return ptr;
+}
+void operator delete(void* p) noexcept
+{
+   if (p != nullptr)
+      RealtimeSafetyMonitor::OnFree();
+   free(p);
+}
+void* operator new[](std::size_t size)
+{
+   RealtimeSafetyMonitor::OnAllocation(size);
+   void* ptr = malloc(size);
+   if (ptr == nullptr)
+      throw std::bad_alloc();
+   return ptr;
+}
+void operator delete[](void* p) noexcept
+{
+   if (p != nullptr)
+      RealtimeSafetyMonitor::OnFree();
+   free(p);
+}
+#define new DEBUG_NEW
+#endif
 #endif
@@ -98,6 +98,8 @@ void Transport::CreateUIControls()
 void Transport::Init()
 {
    IDrawableModule::Init();
+
+   mMeasureTimeRamp.resize(gBufferSize);
 }
 
 void Transport::Poll()
@@ -147,6 +149,8 @@ void Transport::Advance(double ms)
       }
    }
 
+   UpdateMeasureTimeRamp();
+
    if (TheChaosEngine)
       TheChaosEngine->AudioUpdate();
 
@@ -562,6 +566,47 @@ double Transport::GetMeasureTime(double time) const
    return measureTime;
 }
 
+void Transport::UpdateMeasureTimeRamp()
+{
+   if ((int)mMeasureTimeRamp.size() != gBufferSize)
+      mMeasureTimeRamp.resize(gBufferSize);
+
+   double measuresPerSample = gInvSampleRateMs / MsPerBar();
+   for (int i = 0; i < gBufferSize; ++i)
+   {
+      double measureTime = mMeasureTime + i * measuresPerSample;
+      if (mQueuedMeasure != -1 && measureTime >= mJumpFromMeasure)
+         measureTime = mQueuedMeasure + measureTime - mJumpFromMeasure;
+      mMeasureTimeRamp[i] = measureTime;
+   }
+
+   mMeasureTimeRampTime = gTime;
+   mMeasureTimeRampStart = mMeasureTime;
+   mMeasureTimeRampTempo = mTempo;
+   mMeasureTimeRampTimeSigTop = mTimeSigTop;
+   mMeasureTimeRampTimeSigBottom = mTimeSigBottom;
+   mMeasureTimeRampQueuedMeasure = mQueuedMeasure;
+   mMeasureTimeRampJumpFromMeasure = mJumpFromMeasure;
+}
+
+bool Transport::IsMeasureTimeRampCurrent() const
+{
+   return mMeasureTimeRampTime == gTime &&
+          mMeasureTimeRampStart == mMeasureTime &&
+          mMeasureTimeRampTempo == mTempo &&
+          mMeasureTimeRampTimeSigTop == mTimeSigTop &&
+          mMeasureTimeRampTimeSigBottom == mTimeSigBottom &&
+          mMeasureTimeRampQueuedMeasure == mQueuedMeasure &&
+          mMeasureTimeRampJumpFromMeasure == mJumpFromMeasure;
+}
+
+double Transport::GetMeasureTimeForSample(int samplesIn) const
+{
+   if (samplesIn >= 0 && samplesIn < (int)mMeasureTimeRamp.size() && IsMeasureTimeRampCurrent())
+      return mMeasureTimeRamp[samplesIn];
+   return GetMeasureTime(gTime + samplesIn * gInvSampleRateMs);
+}
+
 void Transport::SetQueuedMeasure(double time, int measure)
 {
    mQueuedMeasure = -1; //clear
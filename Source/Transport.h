@@ -134,6 +134,7 @@ public:
    void SetMeasureTime(double measureTime) { mMeasureTime = measureTime; }
    int GetMeasure(double time) const { return (int)floor(GetMeasureTime(time)); }
    double GetMeasureTime(double time) const;
+   double GetMeasureTimeForSample(int samplesIn) const; //GetMeasureTime(gTime + samplesIn * gInvSampleRateMs), read from this buffer's precomputed ramp where possible
    void SetMeasure(int count) { mMeasureTime = mMeasureTime - (int)mMeasureTime + count; }
    void SetDownbeat() { mMeasureTime = mMeasureTime - (int)mMeasureTime - .001; }
    static int CountInStandardMeasure(NoteInterval interval);
@@ -193,6 +194,8 @@ private:
    void Nudge(double amount);
    void SetRandomTempo();
    double GetMeasureTimeInternal(double time) const;
+   void UpdateMeasureTimeRamp();
+   bool IsMeasureTimeRampCurrent() const;
 
    //IDrawableModule
    void DrawModule() override;
@@ -231,6 +234,17 @@ private:
 
    std::list<TransportListenerInfo> mListeners;
    std::list<IAudioPoller*> mAudioPollers;
+
+   //measure time for each sample of the current buffer, with queued jumps applied.
+   //tracks the state it was built from, so anything that moves the transport mid-buffer falls back to GetMeasureTime()
+   std::vector<double> mMeasureTimeRamp;
+   double mMeasureTimeRampTime{ -1 };
+   double mMeasureTimeRampStart{ 0 };
+   float mMeasureTimeRampTempo{ 0 };
+   int mMeasureTimeRampTimeSigTop{ 0 };
+   int mMeasureTimeRampTimeSigBottom{ 0 };
+   int mMeasureTimeRampQueuedMeasure{ -1 };
+   int mMeasureTimeRampJumpFromMeasure{ -1 };
 };
 
 extern Transport* TheTransport;
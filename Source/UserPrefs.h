@@ -296,6 +296,7 @@ public:
    UserPrefDropdownInt samplerate{ "samplerate", 48000, 100, UserPrefCategory::General };
    UserPrefDropdownInt buffersize{ "buffersize", 256, 100, UserPrefCategory::General };
    UserPrefDropdownInt oversampling{ "oversampling", 1, 100, UserPrefCategory::General };
+   UserPrefTextEntryInt engine_block_size{ "engine_block_size", 0, 0, 4096, 5, UserPrefCategory::General };
    UserPrefTextEntryInt width{ "width", 1700, 100, 10000, 5, UserPrefCategory::General };
    UserPrefTextEntryInt height{ "height", 1100, 100, 10000, 5, UserPrefCategory::General };
    UserPrefBool set_manual_window_position{ "set_manual_window_position", false, UserPrefCategory::General };
@@ -312,6 +313,7 @@ public:
    UserPrefBool show_tooltips_on_load{ "show_tooltips_on_load", true, UserPrefCategory::General };
    UserPrefBool show_minimap{ "show_minimap", false, UserPrefCategory::General };
    UserPrefBool immediate_paste{ "immediate_paste", false, UserPrefCategory::General };
+   UserPrefBool adaptive_cpu_quality{ "adaptive_cpu_quality", false, UserPrefCategory::General };
    UserPrefTextEntryFloat record_buffer_length_minutes{ "record_buffer_length_minutes", 30, 1, 120, 5, UserPrefCategory::General };
 #if !BESPOKE_LINUX
    UserPrefBool vst_always_on_top{ "vst_always_on_top", true, UserPrefCategory::General };
@@ -233,7 +233,7 @@ void UserPrefsEditor::UpdateDropdowns(std::vector<DropdownList*> toUpdate)
       for (auto bufferSize : selectedDevice->getAvailableBufferSizes())
       {
          UserPrefs.buffersize.GetDropdown()->AddLabel(ofToString(bufferSize), i);
-         if (bufferSize == gBufferSize / UserPrefs.oversampling.Get())
+         if (bufferSize == TheSynth->GetDeviceBufferSize())
             UserPrefs.buffersize.GetIndex() = i;
          ++i;
       }
@@ -363,6 +363,7 @@ bool UserPrefsEditor::PrefRequiresRestart(UserPref* pref) const
           pref == &UserPrefs.samplerate ||
           pref == &UserPrefs.buffersize ||
           pref == &UserPrefs.oversampling ||
+          pref == &UserPrefs.engine_block_size ||
           pref == &UserPrefs.max_output_channels ||
           pref == &UserPrefs.max_input_channels ||
           pref == &UserPrefs.record_buffer_length_minutes ||
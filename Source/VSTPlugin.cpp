@@ -284,6 +284,10 @@ VSTPlugin::VSTPlugin()
 
    mChannelModulations.resize(kGlobalModulationIdx + 1);
 
+   //reserve room for a busy block up front, so adding events on the audio thread doesn't grow the buffers
+   mMidiBuffer.ensureSize(kMidiBufferReserveBytes);
+   mFutureMidiBuffer.ensureSize(kMidiBufferReserveBytes);
+
    mPluginName = "no plugin loaded";
 }
 
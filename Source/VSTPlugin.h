@@ -144,6 +144,7 @@ private:
    std::string mPluginFormatName;
    std::string mPluginId;
    std::unique_ptr<VSTWindow> mWindow;
+   static const int kMidiBufferReserveBytes = 4096;
    juce::MidiBuffer mMidiBuffer;
    juce::MidiBuffer mFutureMidiBuffer;
    juce::CriticalSection mMidiInputLock;
@@ -83,6 +83,21 @@ void Waveshaper::CreateUIControls()
    mSymbolTableDraw.add_constants();
    mExpressionDraw.register_symbol_table(mSymbolTableDraw);
 
+   //only stateless curves are baked, so history and time are never read
+   mSymbolTableBake.add_variable("x", mExpressionInputBake);
+   mSymbolTableBake.add_variable("x1", mExpressionInputBake);
+   mSymbolTableBake.add_variable("x2", mExpressionInputBake);
+   mSymbolTableBake.add_variable("y1", mExpressionInputBake);
+   mSymbolTableBake.add_variable("y2", mExpressionInputBake);
+   mSymbolTableBake.add_variable("t", mExpressionInputBake);
+   mSymbolTableBake.add_variable("a", mBakeParams[0]);
+   mSymbolTableBake.add_variable("b", mBakeParams[1]);
+   mSymbolTableBake.add_variable("c", mBakeParams[2]);
+   mSymbolTableBake.add_variable("d", mBakeParams[3]);
+   mSymbolTableBake.add_variable("e", mBakeParams[4]);
+   mSymbolTableBake.add_constants();
+   mExpressionBake.register_symbol_table(mSymbolTableBake);
+
    TextEntryComplete(mTextEntry);
 }
 
@@ -108,6 +123,13 @@ void Waveshaper::Process(double time)
    {
       int bufferSize = GetBuffer()->BufferSize();
 
+      const ExpressionCurve::Table* curveTable = nullptr;
+      if (mExpressionValid && mExpressionIsStateless)
+      {
+         ComputeSliders(0);
+         curveTable = mCurve.GetTable(GetCurveParams());
+      }
+
       ChannelBuffer* out = target->GetBuffer();
       for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
       {
@@ -119,18 +141,28 @@ void Waveshaper::Process(double time)
                ComputeSliders(i);
                mExpressionInput = buffer[i] * mRescale;
 
-               mHistPre1 = mBiquadState[ch].mHistPre1;
-               mHistPre2 = mBiquadState[ch].mHistPre2;
-               mHistPost1 = mBiquadState[ch].mHistPost1;
-               mHistPost2 = mBiquadState[ch].mHistPost2;
-
                if (mExpressionInput > max)
                   max = mExpressionInput;
                if (mExpressionInput < min)
                   min = mExpressionInput;
 
-               mT = (gTime + i * gInvSampleRateMs) * .001;
-               buffer[i] = mExpression.value() / mRescale;
+               if (curveTable != nullptr && curveTable->InRange(mExpressionInput) && GetCurveParams() == curveTable->mParams)
+               {
+                  buffer[i] = curveTable->Lookup(mExpressionInput) / mRescale;
+               }
+               else
+               {
+                  if (mExpressionReadsHistory)
+                  {
+                     mHistPre1 = mBiquadState[ch].mHistPre1;
+                     mHistPre2 = mBiquadState[ch].mHistPre2;
+                     mHistPost1 = mBiquadState[ch].mHistPost1;
+                     mHistPost2 = mBiquadState[ch].mHistPost2;
+                  }
+                  if (mExpressionReadsTime)
+                     mT = (gTime + i * gInvSampleRateMs) * .001;
+                  buffer[i] = mExpression.value() / mRescale;
+               }
 
                mBiquadState[ch].mHistPre2 = mBiquadState[ch].mHistPre1;
                mBiquadState[ch].mHistPre1 = mExpressionInput;
@@ -149,12 +181,48 @@ void Waveshaper::Process(double time)
    GetBuffer()->Reset();
 }
 
+Waveshaper::CurveParams Waveshaper::GetCurveParams() const
+{
+   CurveParams params{ mA, mB, mC, mD, mE };
+   for (size_t i = 0; i < params.size(); ++i)
+   {
+      if (!mCurveReadsParam[i])
+         params[i] = 0;
+   }
+   return params;
+}
+
+void Waveshaper::Poll()
+{
+   if (!mExpressionValid || !mExpressionIsStateless)
+      return;
+
+   //only rebake once the parameters the curve reads have held still between polls, modulated parameters go through the interpreter instead
+   CurveParams params = GetCurveParams();
+   if (params == mLastPolledCurveParams && mCurve.NeedsBake(params))
+   {
+      mBakeParams = params;
+      mCurve.Bake(mExpressionBake, mExpressionInputBake, params);
+   }
+   mLastPolledCurveParams = params;
+}
+
 void Waveshaper::TextEntryComplete(TextEntry* entry)
 {
-   exprtk::parser<float> parser;
-   mExpressionValid = parser.compile(mEntryString, mExpression);
+   mExpressionValid = mCurve.Compile(mEntryString, mExpression);
    if (mExpressionValid)
+   {
+      exprtk::parser<float> parser;
       parser.compile(mEntryString, mExpressionDraw);
+      parser.compile(mEntryString, mExpressionBake);
+
+      mExpressionReadsHistory = mCurve.Reads("x1") || mCurve.Reads("x2") || mCurve.Reads("y1") || mCurve.Reads("y2");
+      mExpressionReadsTime = mCurve.Reads("t");
+      mExpressionIsStateless = !mExpressionReadsHistory && !mExpressionReadsTime && !mCurve.HasAssignments();
+      const char* paramNames[] = { "a", "b", "c", "d", "e" };
+      for (size_t i = 0; i < mCurveReadsParam.size(); ++i)
+         mCurveReadsParam[i] = mCurve.Reads(paramNames[i]);
+   }
 }
 
 void Waveshaper::DrawModule()
@@ -32,7 +32,7 @@
 #include "Slider.h"
 #include "ClickButton.h"
 #include "TextEntry.h"
-#include "exprtk/exprtk.hpp"
+#include "ExpressionCurve.h"
 
 class Waveshaper : public IAudioProcessor, public IDrawableModule, public IFloatSliderListener, public ITextEntryListener
 {
@@ -45,6 +45,7 @@ public:
    static bool AcceptsPulses() { return false; }
 
    void CreateUIControls() override;
+   void Poll() override;
 
    //IAudioSource
    void Process(double time) override;
@@ -66,6 +67,9 @@ private:
    void DrawModule() override;
    void GetModuleDimensions(float& w, float& h) override;
 
+   using CurveParams = ExpressionCurve::Params;
+   CurveParams GetCurveParams() const;
+
    float mRescale{ 1 };
    FloatSlider* mRescaleSlider{ nullptr };
    float mA{ 0 };
@@ -85,6 +89,8 @@ private:
    exprtk::expression<float> mExpression;
    exprtk::symbol_table<float> mSymbolTableDraw;
    exprtk::expression<float> mExpressionDraw;
+   exprtk::symbol_table<float> mSymbolTableBake;
+   exprtk::expression<float> mExpressionBake; //a copy for baking the curve table on the main thread
 
    float mExpressionInput{ 0 };
    float mHistPre1{ 0 };
@@ -92,8 +98,16 @@ private:
    float mHistPost1{ 0 };
    float mHistPost2{ 0 };
    float mExpressionInputDraw{ 0 };
+   float mExpressionInputBake{ 0 };
+   CurveParams mBakeParams{};
    float mT{ 0 };
    bool mExpressionValid{ false };
+   ExpressionCurve mCurve;
+   bool mExpressionReadsHistory{ false };
+   bool mExpressionReadsTime{ false };
+   bool mExpressionIsStateless{ false };
+   std::array<bool, 5> mCurveReadsParam{};
+   CurveParams mLastPolledCurveParams{};
    float mSmoothMax{ 0 };
    float mSmoothMin{ 0 };
 
@@ -0,0 +1,171 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2021 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    ExpressionCurveBenchmark.cpp
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+//times the waveshaper's two paths for stateless curves: evaluating the exprtk expression per sample, and looking up the baked ExpressionCurve table.
+//build with -DBESPOKE_BUILD_BENCHMARKS=ON (or configure Source/benchmarks on its own) and run expression_curve_benchmark [seconds of audio per curve]
+
+#include "ExpressionCurve.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+   const int kSampleRate = 48000;
+   const int kBlockSize = 256;
+
+   struct CurveResult
+   {
+      double mExpressionNsPerSample{ 0 };
+      double mTableNsPerSample{ 0 };
+      float mMaxError{ 0 };
+      bool mBaked{ false };
+   };
+
+   double NanosecondsPerSample(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end, int numSamples)
+   {
+      return std::chrono::duration<double, std::nano>(end - start).count() / numSamples;
+   }
+
+   CurveResult RunCurve(const std::string& text, const std::vector<float>& input)
+   {
+      CurveResult result;
+
+      float x = 0;
+      float bakeInput = 0;
+      ExpressionCurve::Params params{ 2, .5f, 0, 0, 0 };
+      exprtk::symbol_table<float> symbolTable;
+      symbolTable.add_variable("x", x);
+      symbolTable.add_variable("a", params[0]);
+      symbolTable.add_variable("b", params[1]);
+      symbolTable.add_constants();
+      exprtk::expression<float> expression;
+      expression.register_symbol_table(symbolTable);
+
+      exprtk::symbol_table<float> bakeSymbolTable;
+      ExpressionCurve::Params bakeParams = params;
+      bakeSymbolTable.add_variable("x", bakeInput);
+      bakeSymbolTable.add_variable("a", bakeParams[0]);
+      bakeSymbolTable.add_variable("b", bakeParams[1]);
+      bakeSymbolTable.add_constants();
+      exprtk::expression<float> bakeExpression;
+      bakeExpression.register_symbol_table(bakeSymbolTable);
+
+      ExpressionCurve curve;
+      if (!curve.Compile(text, expression) || !curve.Compile(text, bakeExpression))
+      {
+         printf("%-28s failed to compile\n", text.c_str());
+         return result;
+      }
+      curve.Bake(bakeExpression, bakeInput, bakeParams);
+      const ExpressionCurve::Table* table = curve.GetTable(params);
+      result.mBaked = table != nullptr;
+
+      std::vector<float> expressionOutput(input.size());
+      std::vector<float> tableOutput(input.size());
+
+      //same per-sample work as Waveshaper::Process() does for each path
+      auto start = std::chrono::steady_clock::now();
+      for (size_t block = 0; block < input.size(); block += kBlockSize)
+      {
+         for (size_t i = block; i < block + kBlockSize && i < input.size(); ++i)
+         {
+            x = input[i];
+            expressionOutput[i] = expression.value();
+         }
+      }
+      auto end = std::chrono::steady_clock::now();
+      result.mExpressionNsPerSample = NanosecondsPerSample(start, end, (int)input.size());
+
+      if (table == nullptr)
+         return result;
+
+      start = std::chrono::steady_clock::now();
+      for (size_t block = 0; block < input.size(); block += kBlockSize)
+      {
+         for (size_t i = block; i < block + kBlockSize && i < input.size(); ++i)
+         {
+            if (table->InRange(input[i]) && params == table->mParams)
+               tableOutput[i] = table->Lookup(input[i]);
+            else
+               tableOutput[i] = 0;
+         }
+      }
+      end = std::chrono::steady_clock::now();
+      result.mTableNsPerSample = NanosecondsPerSample(start, end, (int)input.size());
+
+      for (size_t i = 0; i < input.size(); ++i)
+         result.mMaxError = std::max(result.mMaxError, std::abs(expressionOutput[i] - tableOutput[i]));
+
+      return result;
+   }
+}
+
+int main(int argc, char** argv)
+{
+   double seconds = argc > 1 ? atof(argv[1]) : 10;
+   int numSamples = std::max(kBlockSize, (int)(seconds * kSampleRate));
+
+   //a decaying 110hz sine with a little noise, peaking at 2 so the curves see both their linear and saturated regions
+   std::vector<float> input(numSamples);
+   unsigned int seed = 1;
+   for (int i = 0; i < numSamples; ++i)
+   {
+      seed = seed * 1664525u + 1013904223u;
+      float noise = (seed >> 8) / float(1 << 24) - .5f;
+      float envelope = 2 * std::exp(-3.0f * (i % kSampleRate) / kSampleRate);
+      input[i] = envelope * std::sin(2 * float(M_PI) * 110 * i / kSampleRate) + noise * .01f;
+   }
+
+   const char* curves[] = {
+      "tanh(x*a)",
+      "x/(1+abs(x))",
+      "sin(x*pi*b)",
+      "x-x^3/3",
+      "clamp(-1,x*2,1)",
+      "sgn(x)*(1-exp(-abs(x)*a))"
+   };
+
+   printf("%d samples per curve, a=2 b=.5\n", numSamples);
+   printf("%-28s %14s %14s %9s %12s\n", "curve", "exprtk ns/smp", "table ns/smp", "speedup", "max error");
+   for (const char* text : curves)
+   {
+      CurveResult result = RunCurve(text, input);
+      if (!result.mBaked)
+      {
+         printf("%-28s %14.2f %14s\n", text, result.mExpressionNsPerSample, "not baked");
+         continue;
+      }
+      printf("%-28s %14.2f %14.2f %8.1fx %12.2e\n", text, result.mExpressionNsPerSample, result.mTableNsPerSample,
+             result.mExpressionNsPerSample / result.mTableNsPerSample, result.mMaxError);
+   }
+
+   return 0;
+}